@@ -0,0 +1,49 @@
+#include "Benchmark.hpp"
+
+//	SYSTEM
+#include <cstdlib>
+#include <new>
+
+std::atomic <long long> heapAllocations { 0 };
+
+//	The global heap, counted: scratch that is not a matrix buffer never reaches a memory resource
+void* operator new (size_t size) {
+	++heapAllocations;
+	void* pointer = std::malloc (size == 0 ? 1 : size);
+	if (!pointer) {
+		throw std::bad_alloc {};
+	}
+	return pointer;
+}
+
+void* operator new (size_t size, std::align_val_t alignment) {
+	++heapAllocations;
+	size_t align = static_cast <size_t> (alignment);
+	void* pointer = std::aligned_alloc (align, (size + align - 1) / align * align);
+	if (!pointer) {
+		throw std::bad_alloc {};
+	}
+	return pointer;
+}
+
+void operator delete (void* pointer) noexcept {
+	std::free (pointer);
+}
+
+void operator delete (void* pointer, size_t) noexcept {
+	std::free (pointer);
+}
+
+void operator delete (void* pointer, std::align_val_t) noexcept {
+	std::free (pointer);
+}
+
+void operator delete (void* pointer, size_t, std::align_val_t) noexcept {
+	std::free (pointer);
+}
+
+int main () {
+	Benchmark benchmark {};
+	benchmark.Execute ();
+	return 0;
+}
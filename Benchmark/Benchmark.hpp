@@ -0,0 +1,340 @@
+#pragma once
+
+//  SYSTEM
+#include <random>
+#include <chrono>
+#include <functional>
+#include <atomic>
+
+//  MATRIX
+#include "../Matrix/Matrix.hpp"
+
+//  SOLVER
+#include "../Solver/Solver.hpp"
+#include "../Solver/Batch.hpp"
+
+const int BENCHMARK_REPEATS = 3;
+
+//  Every global operator new of the process, on any thread (Benchmark.cpp)
+extern std::atomic <long long> heapAllocations;
+
+//  Counts the requests passed on to the upstream resource
+class CountingResource final : public std::pmr::memory_resource {
+    private:
+        std::pmr::memory_resource* upstream_ = nullptr;
+        long long allocations_ = 0;
+
+        void* do_allocate (size_t bytes, size_t alignment) override {
+            ++allocations_;
+            return upstream_->allocate (bytes, alignment);
+        }
+        void do_deallocate (void* pointer, size_t bytes, size_t alignment) override {
+            upstream_->deallocate (pointer, bytes, alignment);
+        }
+        bool do_is_equal (const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    public:
+        explicit CountingResource (std::pmr::memory_resource* upstream = std::pmr::get_default_resource ()):
+            upstream_ (upstream)
+            {}
+        long long Allocations () const { return allocations_; }
+};
+
+class Benchmark {
+    private:
+        std::mt19937 generator_ {};
+        std::uniform_real_distribution <> uniformDistribution_ { -1.0, 1.0 };
+
+        Linear::Matrix <double> GenerateRandom (int rows, int cols) {
+            Linear::Matrix <double> ans { rows, cols };
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    ans.At (i, j) = uniformDistribution_ (generator_);
+                }
+            }
+            return ans;
+        }
+
+        //  Best of BENCHMARK_REPEATS runs, in seconds
+        double Measure (const std::function <void ()>& function) {
+            double best = 0;
+            for (int i = 0; i < BENCHMARK_REPEATS; ++i) {
+                auto start = std::chrono::steady_clock::now ();
+                function ();
+                std::chrono::duration <double> elapsed = std::chrono::steady_clock::now () - start;
+                best = (i == 0 ? elapsed.count () : std::min (best, elapsed.count ()));
+            }
+            return best;
+        }
+
+        //  The i-j-k loop operator *= used before the blocked kernel
+        static Linear::Matrix <double> NaiveMultiply (const Linear::Matrix <double>& lhs, const Linear::Matrix <double>& rhs) {
+            int nRows = lhs.Shape ().first, nCols = rhs.Shape ().second, nInner = lhs.Shape ().second;
+            Linear::Matrix <double> ans { nRows, nCols };
+            for (int i = 0; i < nRows; ++i) {
+                for (int j = 0; j < nCols; ++j) {
+                    for (int k = 0; k < nInner; ++k) {
+                        ans.At (i, j) += lhs.At (i, k) * rhs.At (k, j);
+                    }
+                }
+            }
+            return ans;
+        }
+
+        //  Small products are repeated until a run has about 100^3 multiply-adds, so it can be timed
+        void MultiplyBenchmark (int size, bool withNaive) {
+            Linear::Matrix <double> lhs = GenerateRandom (size, size);
+            Linear::Matrix <double> rhs = GenerateRandom (size, size);
+            int repeats = std::max (1, 1000000 / (size * size * size));
+            double flops = 2.0 * size * size * size * repeats;
+
+            double blocked = Measure ([&] () {
+                for (int r = 0; r < repeats; ++r) {
+                    Linear::Matrix <double> ans = lhs * rhs;
+                }
+            });
+            std::cout << "GEMM " << std::setw (5) << size << ": blocked " << std::setw (8) << flops / blocked * 1e-9 << " GFLOP/s";
+            if (withNaive) {
+                double naive = Measure ([&] () {
+                    for (int r = 0; r < repeats; ++r) {
+                        Linear::Matrix <double> ans = NaiveMultiply (lhs, rhs);
+                    }
+                });
+                std::cout << ", naive " << std::setw (8) << flops / naive * 1e-9 << " GFLOP/s"
+                          << ", speedup " << naive / blocked;
+            }
+            std::cout << std::endl;
+        }
+
+        //  Every AddRows reads two rows and writes one
+        void RowBenchmark (int cols) {
+            const int rows = 64;
+            Linear::Matrix <double> matrix = GenerateRandom (rows, cols);
+            std::vector <double> scalar = static_cast <std::vector <double>> (matrix);
+            double bytes = 3.0 * sizeof (double) * cols * rows * (rows - 1);
+
+            double vectorized = Measure ([&] () {
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < rows; ++j) {
+                        if (i != j) {
+                            matrix.AddRows (i, j, 1e-3);
+                        }
+                    }
+                }
+            });
+            double generic = Measure ([&] () {
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < rows; ++j) {
+                        if (i != j) {
+                            Linear::Rows::Axpy <double> (cols, 1e-3, scalar.data () + i * cols, scalar.data () + j * cols);
+                        }
+                    }
+                }
+            });
+            std::cout << "AddRows " << std::setw (6) << cols << ": vectorized " << std::setw (8) << bytes / vectorized * 1e-9 << " GB/s"
+                      << ", scalar " << std::setw (8) << bytes / generic * 1e-9 << " GB/s" << std::endl;
+        }
+
+        void FactorizationBenchmark (int size) {
+            Linear::Matrix <double> matrix = GenerateRandom (size, size);
+            double flops = 2.0 / 3.0 * size * size * size;
+            double blocked = Measure ([&] () { Linear::LU <double> lu = matrix.Factorize (); });
+            std::cout << "LU " << std::setw (7) << size << ": " << std::setw (8) << flops / blocked * 1e-9 << " GFLOP/s, "
+                      << Parallel::Pool ().Size () + 1 << " thread(s)" << std::endl;
+        }
+
+        //  Column-pivoted QR: 4/3 n^3 flops, about half of them in the GEMM updates
+        void QRBenchmark (int size) {
+            Linear::Matrix <double> matrix = GenerateRandom (size, size);
+            double flops = 4.0 / 3.0 * size * size * size;
+            double blocked = Measure ([&] () { Linear::QR <double> qr = matrix.FactorizeQR (); });
+            std::cout << "QR " << std::setw (7) << size << ": " << std::setw (8) << flops / blocked * 1e-9 << " GFLOP/s" << std::endl;
+        }
+
+        //  a + b - 2 * c: one fused pass against three temporaries (the operators before expressions)
+        void ExpressionBenchmark (int size) {
+            Linear::Matrix <double> a = GenerateRandom (size, size), b = GenerateRandom (size, size), c = GenerateRandom (size, size);
+            Linear::Matrix <double> ans { size, size };
+            double bytes = 4.0 * sizeof (double) * size * size;
+
+            double fused = Measure ([&] () { ans = a + b - 2.0 * c; });
+            double temporaries = Measure ([&] () {
+                Linear::Matrix <double> sum { a };
+                sum += b;
+                Linear::Matrix <double> scaled { c };
+                scaled *= 2.0;
+                Linear::Matrix <double> difference { sum };
+                difference -= scaled;
+                ans = difference;
+            });
+            std::cout << "a + b - 2c " << std::setw (5) << size << ": fused " << std::setw (8) << bytes / fused * 1e-9 << " GB/s"
+                      << ", temporaries " << std::setw (8) << bytes / temporaries * 1e-9 << " GB/s" << std::endl;
+        }
+
+        //  Every transpose reads and writes the whole matrix once
+        void TransposeBenchmark (int rows, int cols) {
+            Linear::Matrix <double> matrix = GenerateRandom (rows, cols);
+            double bytes = 2.0 * sizeof (double) * rows * cols;
+
+            double blocked = Measure ([&] () { matrix.Transpose (); });
+            //  The column-strided copy Transpose made before
+            double naive = Measure ([&] () {
+                auto shape = matrix.Shape ();
+                Linear::Matrix <double> temp { shape.second, shape.first };
+                for (int i = 0; i < shape.first; ++i) {
+                    const double* row = matrix.Row (i);
+                    for (int j = 0; j < shape.second; ++j) {
+                        temp (j, i) = row[j];
+                    }
+                }
+                matrix = std::move (temp);
+            });
+            const char* kind = (rows == 1 || cols == 1 ? "reshape  " : (rows == cols ? "in place " : "tiled    "));
+            std::cout << "Transpose " << std::setw (5) << rows << " x " << std::setw (5) << cols << ": "
+                      << kind << std::setw (8) << bytes / blocked * 1e-9 << " GB/s"
+                      << ", naive " << std::setw (8) << bytes / naive * 1e-9 << " GB/s" << std::endl;
+        }
+
+        //  Matrix buffers of one dense solve: straight from the heap, then from a monotonic arena.
+        //  The resources see only matrix buffers, so the global heap is counted beside them
+        void SolverBenchmark (int size) {
+            Linear::Matrix <double> main = GenerateRandom (size, size), rhs = GenerateRandom (size, 1);
+            CountingResource heap {}, upstream {};
+            auto solve = [&] () {
+                Solver solver { main, rhs };
+                PairMatrix ans = solver.Execute ();
+            };
+            //  A solve before the runs, so that reused scratch (GEMM packing) is already there
+            solve ();
+
+            long long heapBefore = heapAllocations;
+            double heapTime = Measure ([&] () {
+                Memory::Scope scope { &heap };
+                solve ();
+            });
+            long long heapNew = heapAllocations - heapBefore;
+            long long arenaBefore = heapAllocations;
+            double arenaTime = Measure ([&] () {
+                //  Room for the copies, the factorization and the answer
+                std::pmr::monotonic_buffer_resource arena { 8 * sizeof (double) * size * (size + 1), &upstream };
+                Memory::Scope scope { &arena };
+                solve ();
+            });
+            long long arenaNew = heapAllocations - arenaBefore;
+            std::cout << "Solver " << std::setw (5) << size << ": heap " << std::setw (4) << heap.Allocations () / BENCHMARK_REPEATS
+                      << " buffers, " << std::setw (4) << heapNew / BENCHMARK_REPEATS << " operator new, " << std::setw (8) << heapTime
+                      << " s; arena " << std::setw (4) << upstream.Allocations () / BENCHMARK_REPEATS
+                      << " upstream, " << std::setw (4) << arenaNew / BENCHMARK_REPEATS << " operator new, " << std::setw (8) << arenaTime << " s" << std::endl;
+        }
+
+        //  count right-hand sides of one main: a Solver each, one Solver for them one by one, and as a block
+        void RightHandSidesBenchmark (int size, int count) {
+            Linear::Matrix <double> main = GenerateRandom (size, size) + static_cast <double> (size) * Linear::Matrix <double>::Eye (size);
+            Linear::Matrix <double> block = GenerateRandom (size, count);
+            std::vector <Linear::Matrix <double>> columns (count, Linear::Matrix <double> { size, 1 });
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < count; ++j) {
+                    columns[j].At (i, 0) = block.At (i, j);
+                }
+            }
+
+            double fresh = Measure ([&] () {
+                for (auto& column : columns) {
+                    PairMatrix ans = Solver { main, column }.Execute ();
+                }
+            });
+            double stream = Measure ([&] () {
+                Solver solver { main };
+                for (auto& column : columns) {
+                    PairMatrix ans = solver.Solve (column);
+                }
+            });
+            double blocked = Measure ([&] () {
+                PairMatrix ans = Solver { main, block }.Execute ();
+            });
+            std::cout << "Right-hand sides " << std::setw (5) << size << " x " << std::setw (4) << count << ": Solver each " << std::setw (8) << fresh
+                      << " s, one by one " << std::setw (8) << stream << " s, block " << std::setw (8) << blocked << " s" << std::endl;
+        }
+
+        //  count systems one Solver at a time, and as one batch
+        void BatchBenchmark (int size, int count) {
+            std::vector <Linear::Matrix <double>> mains {}, rhss {};
+            for (int s = 0; s < count; ++s) {
+                //  Well conditioned, so that every system is regular
+                mains.push_back (GenerateRandom (size, size) + static_cast <double> (size) * Linear::Matrix <double>::Eye (size));
+                rhss.push_back (GenerateRandom (size, 1));
+            }
+            Linear::Matrix <double> batch = BatchSolver::Interleave (mains), batchRhs = BatchSolver::Interleave (rhss);
+
+            double oneByOne = Measure ([&] () {
+                for (int s = 0; s < count; ++s) {
+                    PairMatrix ans = Solver { mains[s], rhss[s] }.Execute ();
+                }
+            });
+            double batched = Measure ([&] () {
+                BatchSolver solver { size, batch };
+                Linear::Matrix <double> ans = solver.Solve (batchRhs);
+            });
+            std::cout << "Batch " << std::setw (3) << size << " x " << std::setw (3) << size << ", " << std::setw (6) << count
+                      << " systems: Solver " << std::setw (8) << oneByOne << " s, batch " << std::setw (8) << batched
+                      << " s, x" << oneByOne / batched << std::endl;
+        }
+
+    public:
+        void Execute () {
+            std::cout << std::fixed << std::setprecision (2);
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "MATRIX MULTIPLICATION" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            //  31 is below Gemm::SMALL_SIZE and takes the simple loop, 33 is the smallest blocked size
+            for (int size : { 31, 33, 50, 100, 200, 500, 1000 }) {
+                MultiplyBenchmark (size, true);
+            }
+            MultiplyBenchmark (2000, false);
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "ROW OPERATIONS" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            for (int cols : { 1000, 4000, 100000 }) {
+                RowBenchmark (cols);
+            }
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "LU AND QR FACTORIZATIONS" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            for (int size : { 500, 1000, 2000, 4000 }) {
+                FactorizationBenchmark (size);
+            }
+            for (int size : { 500, 1000, 2000 }) {
+                QRBenchmark (size);
+            }
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "ELEMENTWISE EXPRESSIONS" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            for (int size : { 100, 1000, 3000 }) {
+                ExpressionBenchmark (size);
+            }
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "TRANSPOSE" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            TransposeBenchmark (1000, 1000);
+            TransposeBenchmark (4096, 4096);
+            TransposeBenchmark (3000, 5000);
+            TransposeBenchmark (1, 1000000);
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "SOLVER ALLOCATIONS" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            for (int size : { 10, 100, 300 }) {
+                SolverBenchmark (size);
+            }
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "RIGHT-HAND SIDES" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            RightHandSidesBenchmark (100, 100);
+            RightHandSidesBenchmark (500, 100);
+            std::cout << "----------------------------------" << std::endl;
+            std::cout << "BATCHED SOLVE" << std::endl;
+            std::cout << "----------------------------------" << std::endl;
+            BatchBenchmark (10, 100000);
+            BatchBenchmark (50, 10000);
+        }
+};
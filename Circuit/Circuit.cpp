@@ -17,66 +17,95 @@ std::ostream& operator << (std::ostream& stream, RV rv) {
     return stream;
 }
 
-void DFS::VertexEntry (int cur) {
-    used_[cur] = true;
-    curPath_.push_back (cur);
+void SpanningForest::BuildAdjacency () {
+    if (!table_->IsCompressed ()) {
+        throw std::invalid_argument ("Adjacency table is not compressed");
+    }
+    const auto& rowStarts = table_->RowStarts ();
+    const auto& cols = table_->Cols ();
+    const auto& values = table_->Values ();
+    for (int i = 0; i < table_->Shape ().first; ++i) {
+        for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+            if ((i != cols[pos]) && (values[pos] != RV {})) {
+                adjacency_[i].push_back (cols[pos]);
+            }
+        }
+    }
 }
 
-void DFS::VertexOutro (int cur) {
-    curPath_.pop_back ();
-    used_[cur] = false;
+void SpanningForest::Grow (Vertex root) {
+    std::queue <Vertex> queue {};
+    roots_.push_back (root);
+    depth_[root] = 0;
+    queue.push (root);
+    while (!queue.empty ()) {
+        Vertex cur = queue.front ();
+        queue.pop ();
+        for (Vertex next : adjacency_[cur]) {
+            if (depth_[next] == -1) {
+                parent_[next] = cur;
+                depth_[next] = depth_[cur] + 1;
+                queue.push (next);
+            }
+        }
+    }
 }
 
-bool DFS::PushIfDifferent () {
-    int temp = cyclesSets_.size ();
-    cyclesSets_.insert ({ curPath_.begin (), curPath_.end () });
-    if (cyclesSets_.size () != temp) {
-        //  Size increased, => different cycle
-        cycles_.push_back (curPath_);
-        return true;
+std::vector <Vertex> SpanningForest::FundamentalCycle (Vertex from, Vertex to) const {
+    //  Tree path from -> to, closed by the edge to -> from
+    std::vector <Vertex> head { from }, tail { to };
+    while (head.back () != tail.back ()) {
+        if (depth_[head.back ()] >= depth_[tail.back ()]) {
+            head.push_back (parent_[head.back ()]);
+        }
+        else {
+            tail.push_back (parent_[tail.back ()]);
+        }
     }
-    return false;
+    tail.pop_back ();
+    head.insert (head.end (), tail.rbegin (), tail.rend ());
+    head.push_back (from);
+    return head;
 }
 
-void DFS::Step (int cur, int prev) {
-    if (used_[cur]) {
-        //  it is a complete cycle only if the first vertex equals the last one
-        if (cur != curPath_.front ()) {
-            return;
+void SpanningForest::Build () {
+    BuildAdjacency ();
+    for (int i = 0; i < adjacency_.size (); ++i) {
+        if (depth_[i] == -1) {
+            Grow (i);
         }
-        curPath_.push_back (cur);
-        PushIfDifferent ();
-        curPath_.pop_back ();
-        return;
     }
-    else {
-        VertexEntry (cur);
-        for (int i = 0; i < table_->Shape ().first; ++i) {
-            if (((*table_).At (cur, i) != RV {}) && (i != cur) && (i != prev)) {
-                Step (i, cur);
+    for (int i = 0; i < adjacency_.size (); ++i) {
+        for (Vertex j : adjacency_[i]) {
+            bool treeEdge = (parent_[i] == j) || (parent_[j] == i);
+            if ((i < j) && !treeEdge) {
+                cycles_.push_back (FundamentalCycle (i, j));
             }
         }
-        VertexOutro (cur);
     }
 }
 
-std::vector <std::vector <Vertex>> DFS::GetCycles () {
-    for (int i = 0; i < used_.size (); ++i) {
-        Step (i, -1);
-    }
+std::vector <std::vector <Vertex>> SpanningForest::GetCycles () const {
     return cycles_;
 }
 
+const std::vector <Vertex>& SpanningForest::GetRoots () const {
+    return roots_;
+}
+
 void Circuit::ComputeMaxIdx () {
+    const auto& rowStarts = adjTable_.RowStarts ();
+    const auto& cols = adjTable_.Cols ();
+    const auto& values = adjTable_.Values ();
     for (int i = 0; i < adjTable_.Shape ().first; ++i) {
-        for (int j = 0; j < adjTable_.Shape ().second; ++j) {
-            if (adjTable_.At (i, j) != RV {}) {
-                Edge edge = { i, j };
+        for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+            if (values[pos] != RV {}) {
+                Edge edge = { i, cols[pos] };
                 bool containsReversedEdge = false;
                 int variableIdx = GetVariableIdx (edge, containsReversedEdge);
                 maxIdx_ = std::max <int> (maxIdx_, variableIdx);
             }
-        }                
+        }
     }
 }
 
@@ -84,7 +113,6 @@ int Circuit::GetVariableIdx (Edge edge, bool& containsReversedEdge) {
     if (edge.first == edge.second) {
         throw std::invalid_argument ("Cyclic edge");
     }
-    static int counter = 0;
     int ans = 0;
     try {
         ans = edgesToVariables_.at (edge);
@@ -98,52 +126,201 @@ int Circuit::GetVariableIdx (Edge edge, bool& containsReversedEdge) {
             return ans;
         }
         catch (std::out_of_range &ex) {
-            ans = counter++;
+            //  Indices are per circuit: the next one is the number of edges seen so far
+            ans = edgesToVariables_.size ();
             edgesToVariables_[edge] = ans;
         }
     }
     return ans;
 }
 
-PairMatrix Circuit::FirstKhLaw () {
+PairSparse Circuit::FirstKhLaw () {
+    //  The equations of one component sum to zero, so its root's one is dropped
     int adjTableSize = adjTable_.Shape ().first;   //  to avoid static_cast
-    Linear::Matrix <double> lhs { adjTableSize, maxIdx_ + 1 };
-    Linear::Matrix <double> rhs { adjTableSize, 1, 0 };
+    int nEquations = adjTableSize - forest_.GetRoots ().size ();
+    std::vector <bool> isRoot (adjTableSize, false);
+    for (Vertex root : forest_.GetRoots ()) {
+        isRoot[root] = true;
+    }
+    Linear::SparseMatrix <double> lhs { nEquations, maxIdx_ + 1 };
+    Linear::Matrix <double> rhs { nEquations, 1, 0 };
+    const auto& rowStarts = adjTable_.RowStarts ();
+    const auto& cols = adjTable_.Cols ();
+    const auto& values = adjTable_.Values ();
+    int row = 0;
     for (int i = 0; i < adjTable_.Shape ().first; ++i) {
-        for (int j = 0; j < adjTable_.Shape ().second; ++j) {
-            if (adjTable_.At (i, j) != RV {}) {
-                Edge edge = { i, j };
+        if (isRoot[i]) {
+            continue;
+        }
+        for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+            if (values[pos] != RV {}) {
+                Edge edge = { i, cols[pos] };
                 bool containsReversedEdge = false;
                 int variableIdx = GetVariableIdx (edge, containsReversedEdge);
-                lhs.At (i, variableIdx) = 1 * (containsReversedEdge ? -1 : 1);
+                lhs.Insert (row, variableIdx) = 1 * (containsReversedEdge ? -1 : 1);
             }
         }
+        ++row;
     }
+    lhs.Compress (Linear::SparseMatrix <double>::Duplicates::LAST);
     return { lhs, rhs };
 }
 
-PairMatrix Circuit::SecondKhLaw () {
+PairSparse Circuit::SecondKhLaw () {
     int cyclesSize = cycles_.size ();   //  to avoid static_cast
-    Linear::Matrix <double> lhs { cyclesSize, maxIdx_ + 1 };
+    Linear::SparseMatrix <double> lhs { cyclesSize, maxIdx_ + 1 };
     Linear::Matrix <double> rhs { cyclesSize, 1, 0 };
     for (int i = 0; i < cycles_.size (); ++i) {
         for (int j = 0; j < cycles_[i].size () - 1; ++j) {
             Edge edge = { cycles_[i][j], cycles_[i][j+1] };
             bool containsReversedEdge = false;
             int variableIdx = GetVariableIdx (edge, containsReversedEdge);
-            lhs.At (i, variableIdx) = adjTable_.At (edge.first, edge.second).Resistance () * (containsReversedEdge ? -1 : 1);
-            rhs.At (i, 0) += adjTable_.At (edge.first, edge.second).Voltage ();
+            RV rv = adjTable_.At (edge.first, edge.second);
+            lhs.Insert (i, variableIdx) = rv.Resistance () * (containsReversedEdge ? -1 : 1);
+            rhs.At (i, 0) += rv.Voltage ();
         }
     }
+    lhs.Compress (Linear::SparseMatrix <double>::Duplicates::LAST);
     return { lhs, rhs };
 }
 
+PairSparse Circuit::LoopSystem () {
+    PairSparse ans = FirstKhLaw ();
+    PairSparse temp = SecondKhLaw ();
+    ans.first.AppendRows (temp.first);
+    ans.second.AppendRows (temp.second);
+    return ans;
+}
+
 PairMatrix Circuit::Execute () {
-    PairMatrix temp = FirstKhLaw ();
-    lhs_ = temp.first;
-    rhs_ = temp.second;
-    temp = SecondKhLaw ();
-    lhs_.AppendRows (temp.first);
-    rhs_.AppendRows (temp.second);
+    PairSparse system = LoopSystem ();
+    lhs_ = system.first.ToDense ();
+    rhs_ = system.second;
     return { lhs_, rhs_ };
-}
\ No newline at end of file
+}
+
+void Circuit::ComputeNodalIdx () {
+    int nVertices = adjTable_.Shape ().first;
+    nodeIdx_.assign (nVertices, 0);
+    for (Vertex root : forest_.GetRoots ()) {
+        nodeIdx_[root] = -1;
+    }
+    int counter = 0;
+    for (int i = 0; i < nVertices; ++i) {
+        if (nodeIdx_[i] != -1) {
+            nodeIdx_[i] = counter++;
+        }
+    }
+    sourceIdx_.clear ();
+    for (auto& entry : edgesToVariables_) {
+        if (adjTable_.At (entry.first.first, entry.first.second).Resistance () == 0) {
+            sourceIdx_[entry.first] = counter++;
+        }
+    }
+}
+
+PairSparse Circuit::NodalSystem () {
+    //  Every edge a -> b obeys R * I = phi_a - phi_b + V, KCL sums currents leaving a vertex
+    ComputeNodalIdx ();
+    int size = (adjTable_.Shape ().first - forest_.GetRoots ().size ()) + sourceIdx_.size ();
+    Linear::SparseMatrix <double> lhs { size, size };
+    Linear::Matrix <double> rhs { size, 1, 0 };
+    for (auto& entry : edgesToVariables_) {
+        Edge edge = entry.first;
+        RV rv = adjTable_.At (edge.first, edge.second);
+        int a = nodeIdx_[edge.first], b = nodeIdx_[edge.second];
+        if (rv.Resistance () != 0) {
+            double conductance = 1.0 / rv.Resistance ();
+            if (a != -1) {
+                lhs.Add (a, a, conductance);
+                rhs.At (a, 0) -= conductance * rv.Voltage ();
+            }
+            if (b != -1) {
+                lhs.Add (b, b, conductance);
+                rhs.At (b, 0) += conductance * rv.Voltage ();
+            }
+            if (a != -1 && b != -1) {
+                lhs.Add (a, b, -conductance);
+                lhs.Add (b, a, -conductance);
+            }
+        }
+        else {
+            int k = sourceIdx_.at (edge);
+            if (a != -1) {
+                lhs.Add (a, k, 1);
+                lhs.Add (k, a, 1);
+            }
+            if (b != -1) {
+                lhs.Add (b, k, -1);
+                lhs.Add (k, b, -1);
+            }
+            rhs.At (k, 0) = - rv.Voltage ();
+        }
+    }
+    lhs.Compress (Linear::SparseMatrix <double>::Duplicates::SUM);
+    return { lhs, rhs };
+}
+
+Linear::Matrix <double> Circuit::Currents (Mode mode) {
+    switch (mode) {
+        case Mode::LOOP: {
+            return LoopCurrents ();
+        }
+        case Mode::NODAL: {
+            return NodalCurrents ();
+        }
+        case Mode::NODAL_ITERATIVE: {
+            return IterativeCurrents ();
+        }
+    }
+    throw std::invalid_argument ("Unknown circuit mode");
+}
+
+Linear::Matrix <double> Circuit::LoopCurrents () {
+    PairSparse system = LoopSystem ();
+    Solver solver { system.first, system.second };
+    return solver.Execute ().second;
+}
+
+Linear::Matrix <double> Circuit::NodalCurrents () {
+    PairSparse system = NodalSystem ();
+    return EdgeCurrents (Linear::SparseLU <double> { system.first }.Solve (system.second));
+}
+
+Linear::Matrix <double> Circuit::IterativeCurrents (const Iterative::Options& options) {
+    //  Without sources the grounded nodal matrix is symmetric positive definite
+    PairSparse system = NodalSystem ();
+    int size = system.second.Shape ().first;
+    std::vector <double> rhs (size);
+    for (int i = 0; i < size; ++i) {
+        rhs[i] = system.second.At (i, 0);
+    }
+    Iterative::Jacobi preconditioner { system.first };
+    Iterative::Result result = (sourceIdx_.empty () ?
+                                Iterative::CG (system.first, rhs, preconditioner, options) :
+                                Iterative::GMRES (system.first, rhs, preconditioner, options));
+    if (!result.converged) {
+        std::stringstream strstream {};
+        strstream << "Iterative solver did not converge: residual = " << result.residuals.back () << " after " << result.Iterations () << " iterations";
+        throw std::runtime_error (strstream.str ());
+    }
+    return EdgeCurrents ({ size, 1, result.solution });
+}
+
+Linear::Matrix <double> Circuit::EdgeCurrents (const Linear::Matrix <double>& solution) const {
+    auto potential = [&] (Vertex vertex) {
+        return (nodeIdx_[vertex] == -1 ? 0.0 : solution.At (nodeIdx_[vertex], 0));
+    };
+    Linear::Matrix <double> ans { maxIdx_ + 1, 1, 0 };
+    for (auto& entry : edgesToVariables_) {
+        Edge edge = entry.first;
+        RV rv = adjTable_.At (edge.first, edge.second);
+        if (rv.Resistance () != 0) {
+            ans.At (entry.second, 0) = (potential (edge.first) - potential (edge.second) + rv.Voltage ()) / rv.Resistance ();
+        }
+        else {
+            ans.At (entry.second, 0) = solution.At (sourceIdx_.at (edge), 0);
+        }
+    }
+    return ans;
+}
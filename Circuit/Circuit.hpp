@@ -3,15 +3,21 @@
 //  SYSTEM
 #include <vector>
 #include <map>
-#include <set>
+#include <queue>
 
 //  MATRIX
 #include "../Matrix/Matrix.hpp"
+#include "../Matrix/SparseMatrix.hpp"
+
+//  SOLVER
+#include "../Solver/Solver.hpp"
 
 //  TYPEDEFS
 using Vertex = int;
 using Edge = std::pair <Vertex, Vertex>;
 using PairMatrix = std::pair <Linear::Matrix <double>, Linear::Matrix <double>>;
+//  Sparse coefficients, dense right-hand side
+using PairSparse = std::pair <Linear::SparseMatrix <double>, Linear::Matrix <double>>;
 
 //  So we can make them keys in std::map
 bool operator < (Edge lhs, Edge rhs);
@@ -41,43 +47,60 @@ struct RV {  //  Resistance + voltage
 bool operator != (RV lhs, RV rhs);
 std::ostream& operator << (std::ostream& stream, RV rv);
 
-class DFS final {
+//  Breadth-first spanning forest of the circuit graph. Every edge outside the
+//  forest closes exactly one fundamental cycle, which gives E - V + C independent
+//  loops (C = number of connected components) in time linear in their total length.
+class SpanningForest final {
     private:
+        //  GIVEN
+        const Linear::SparseMatrix <RV>* table_ {};
+
         //  COMPUTATIONS
-        Linear::Matrix <RV>* table_ {};
-        std::vector <bool> used_ {};
-        std::vector <int> curPath_ {};
-        std::set <std::set <Vertex>> cyclesSets_ {};
+        std::vector <std::vector <Vertex>> adjacency_ {};
+        std::vector <Vertex> parent_ {};
+        std::vector <int> depth_ {};
 
         //  RESULT
+        std::vector <Vertex> roots_ {};
         std::vector <std::vector <Vertex>> cycles_ {};
 
-        //  VERTEX AND PATH METHODS
-        void VertexEntry (int cur);
-        void VertexOutro (int cur);
-        bool PushIfDifferent ();
-
         //  ALGORITHM
-        void Step (int cur, int prev);
+        void BuildAdjacency ();
+        void Grow (Vertex root);
+        std::vector <Vertex> FundamentalCycle (Vertex from, Vertex to) const;
+        void Build ();
     public:
         //  CTOR
-        DFS (Linear::Matrix <RV>* table):
+        SpanningForest (const Linear::SparseMatrix <RV>* table):
             table_ (table),
-            used_ (table->Shape ().first, false),
-            curPath_ ({})
-            {}
+            adjacency_ (table->Shape ().first),
+            parent_ (table->Shape ().first, -1),
+            depth_ (table->Shape ().first, -1)
+            {
+                Build ();
+            }
 
         //  CYCLES
-        std::vector <std::vector <Vertex>> GetCycles ();
+        std::vector <std::vector <Vertex>> GetCycles () const;
+
+        //  One vertex per connected component, its KCL equation is redundant
+        const std::vector <Vertex>& GetRoots () const;
 };
 
 class Circuit final {
+    public:
+        //  FORMULATIONS
+        enum class Mode {
+            LOOP = 0,   //  KCL + KVL over fundamental loops, unknowns are edge currents
+            NODAL = 1,  //  Modified nodal analysis, unknowns are node potentials
+            NODAL_ITERATIVE = 2 //  Same system solved by CG (no sources) or GMRES, for networks too large to factorize
+        };
     private:
         //  GIVEN
-        Linear::Matrix <RV> adjTable_ {};
+        Linear::SparseMatrix <RV> adjTable_ {};
 
         //  TOOLS
-        DFS dfs_;
+        SpanningForest forest_;
 
         //  COMPUTATIONS
         int maxIdx_ = 0;
@@ -85,16 +108,22 @@ class Circuit final {
         std::vector <std::vector <Vertex>> cycles_ {};
         void ComputeMaxIdx ();
 
+        //  NODAL ANALYSIS INDICES
+        std::vector <int> nodeIdx_ {};          //  -1 for grounded roots
+        std::map <Edge, int> sourceIdx_ {};     //  zero-resistance edges
+        void ComputeNodalIdx ();
+
         //  RESULT
         Linear::Matrix <double> lhs_ {};
         Linear::Matrix <double> rhs_ {};
     public:
         //  CTOR
-        Circuit (const Linear::Matrix <RV>& adjTable):
+        //  adjTable must be compressed
+        Circuit (const Linear::SparseMatrix <RV>& adjTable):
             adjTable_ (adjTable),
-            dfs_ (&adjTable_),
+            forest_ (&adjTable_),
             edgesToVariables_ ({}),
-            cycles_ (dfs_.GetCycles ())
+            cycles_ (forest_.GetCycles ())
             {
                 ComputeMaxIdx ();
             }
@@ -103,10 +132,26 @@ class Circuit final {
         int GetVariableIdx (Edge edge, bool& containsReversedEdge);
 
         //  KIRCHHOFF'S LAWS
-        PairMatrix FirstKhLaw ();
-        PairMatrix SecondKhLaw ();
+        PairSparse FirstKhLaw ();
+        PairSparse SecondKhLaw ();
+
+        //  MODIFIED NODAL ANALYSIS
+        //  One row per non-root vertex (its potential, roots are grounded) and one per
+        //  zero-resistance edge (its current, such an edge fixes a potential difference)
+        PairSparse NodalSystem ();
+
+        //  KCL rows stacked over KVL rows
+        PairSparse LoopSystem ();
 
         //  EXECUTE
         PairMatrix Execute ();
 
+        //  Current through every edge, indexed by GetVariableIdx
+        Linear::Matrix <double> Currents (Mode mode = Mode::LOOP);
+        Linear::Matrix <double> LoopCurrents ();
+        Linear::Matrix <double> NodalCurrents ();
+        Linear::Matrix <double> IterativeCurrents (const Iterative::Options& options = {});
+        //  Edge currents from the solution of NodalSystem
+        Linear::Matrix <double> EdgeCurrents (const Linear::Matrix <double>& solution) const;
+
 };
\ No newline at end of file
@@ -3,13 +3,27 @@
 //  SYSTEM
 #include <random>
 #include <fstream>
+#include <cstdint>
+#include <set>
 
 //  MATRIX
 #include "../Matrix/Matrix.hpp"
+#include "../Matrix/SparseMatrix.hpp"
+#include "../Matrix/SparseLU.hpp"
+#include "../Matrix/FixedMatrix.hpp"
+
+//  SOLVER
+#include "../Solver/Solver.hpp"
+#include "../Solver/Batch.hpp"
+
+//  CIRCUIT
+#include "../Circuit/Circuit.hpp"
 
 const int DEFAULT_SIZE = 50;
 const double UNIFORM_MIN = -0.5;
 const double UNIFORM_MAX = 0.5;
+//  Workers of the pools the parallel tests make for themselves
+const int PARALLEL_TEST_THREADS = 4;
 
 class Generator {
     private:
@@ -121,6 +135,734 @@ class Generator {
             return result;
         }
 
+        Linear::Matrix <double> GenerateRandom (int rows, int cols) {
+            Linear::Matrix <double> ans { rows, cols };
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    ans.At (i, j) = uniformDistribution_ (generator_);
+                }
+            }
+            return ans;
+        }
+
+        bool MultiplyTest (int rows, int inner, int cols) {
+            Linear::Matrix <double> m1 = GenerateRandom (rows, inner);
+            Linear::Matrix <double> m2 = GenerateRandom (inner, cols);
+            Linear::Matrix <double> myAns = m1 * m2;
+            double maxDifference = 0.0;
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    double correctAns = 0.0;
+                    for (int k = 0; k < inner; ++k) {
+                        correctAns += m1.At (i, k) * m2.At (k, j);
+                    }
+                    maxDifference = std::max (maxDifference, std::fabs (myAns.At (i, j) - correctAns));
+                }
+            }
+            return maxDifference < EPS;
+        }
+
+        //  One factorization, several right-hand sides, inverse and rank
+        bool FactorizationTest (int size = DEFAULT_SIZE, int nRhs = 3) {
+            Linear::Matrix <double> m1 = GenerateRandom (size, size);
+            Linear::Matrix <double> rhs = GenerateRandom (size, nRhs);
+            Linear::LU <double> lu = m1.Factorize ();
+
+            Linear::Matrix <double> residual = m1 * lu.Solve (rhs) - rhs;
+            Linear::Matrix <double> eyeResidual = m1 * lu.Inverse () - Linear::Matrix <double>::Eye (size);
+            double maxDifference = 0.0;
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < nRhs; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (residual.At (i, j)));
+                }
+                for (int j = 0; j < size; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (eyeResidual.At (i, j)));
+                }
+            }
+            return (maxDifference < EPS) && (lu.Rank () == size) && (GenerateSingular (size).Rank () == size - 1);
+        }
+
+        //  Column-pivoted QR of a rows x cols matrix of the given rank, scaled far from EPS:
+        //  A * P = Q * R, orthonormal Q, the rank and the null space
+        bool QRTest (int rows, int cols, int rank, double scale) {
+            Linear::Matrix <double> m = scale * (GenerateRandom (rows, rank) * GenerateRandom (rank, cols));
+            Linear::QR <double> qr = m.FactorizeQR ();
+            Linear::Matrix <double> q = qr.Q (), qT = q;
+            qT.Transpose ();
+            Linear::Matrix <double> product = q * qr.R (), orthogonality = qT * q - Linear::Matrix <double>::Eye (std::min (rows, cols));
+            double maxDifference = 0.0;
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (product.At (i, j) - m.At (i, qr.Permutation ()[j])) / scale);
+                }
+            }
+            for (int i = 0; i < std::min (rows, cols); ++i) {
+                for (int j = 0; j < std::min (rows, cols); ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (orthogonality.At (i, j)));
+                }
+            }
+            if (rank < cols) {
+                Linear::Matrix <double> kernel = m * qr.NullSpace ();
+                for (int i = 0; i < rows; ++i) {
+                    for (int j = 0; j < cols - rank; ++j) {
+                        maxDifference = std::max (maxDifference, std::fabs (kernel.At (i, j)) / scale);
+                    }
+                }
+            }
+            return (maxDifference < EPS) && (qr.Rank () == rank) && (m.Rank () == rank) && (qr.NullSpace ().Shape ().second == cols - rank);
+        }
+
+        //  Assembly with duplicates, conversions, SpMV and transpose against dense results
+        bool SparseTest (int rows, int cols, int nEntries) {
+            std::uniform_int_distribution <> rowDistribution { 0, rows - 1 }, colDistribution { 0, cols - 1 };
+            Linear::SparseMatrix <double> sparse { rows, cols };
+            Linear::Matrix <double> dense { rows, cols };
+            for (int t = 0; t < nEntries; ++t) {
+                int i = rowDistribution (generator_), j = colDistribution (generator_);
+                double value = uniformDistribution_ (generator_);
+                sparse.Add (i, j, value);
+                dense.At (i, j) += value;
+            }
+            Linear::Matrix <double> x = GenerateRandom (cols, 2);
+            //  Pending entries are not part of the CSR yet, so every product refuses them
+            bool pendingRefused = false;
+            try {
+                sparse * x;
+            }
+            catch (std::logic_error& ex) {
+                pendingRefused = true;
+            }
+            sparse.Compress ();
+            Linear::Matrix <double> productDifference = sparse * x - dense * x;
+            Linear::SparseMatrix <double> transposed { dense };
+            transposed.Transpose ();
+            Linear::Matrix <double> transposedDifference = transposed.ToDense ();
+            Linear::Matrix <double> denseTransposed = dense;
+            denseTransposed.Transpose ();
+            transposedDifference -= denseTransposed;
+            Linear::Matrix <double> difference = sparse.ToDense () - dense;
+            double maxDifference = 0.0;
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (difference.At (i, j)));
+                    maxDifference = std::max (maxDifference, std::fabs (transposedDifference.At (j, i)));
+                }
+                for (int j = 0; j < 2; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (productDifference.At (i, j)));
+                }
+            }
+            return pendingRefused && (maxDifference < EPS);
+        }
+
+        //  Random entries around a diagonal that is zero in every fifth row, so pivoting is needed
+        Linear::SparseMatrix <double> GenerateSparseSystem (int size, int nEntries) {
+            std::uniform_int_distribution <> distribution { 0, size - 1 };
+            Linear::SparseMatrix <double> ans { size, size };
+            for (int i = 0; i < size; ++i) {
+                if (i % 5 != 0) {
+                    ans.Add (i, i, 4.0);
+                }
+                ans.Add (i, (i + 1) % size, 1.0);
+                ans.Add ((i + 1) % size, i, 1.0);
+            }
+            for (int t = 0; t < nEntries; ++t) {
+                ans.Add (distribution (generator_), distribution (generator_), uniformDistribution_ (generator_));
+            }
+            ans.Compress ();
+            return ans;
+        }
+
+        //  Sparse LU, its refactorization with new values and the sparse path of Solver
+        bool SparseSolveTest (int size, int nEntries) {
+            Linear::SparseMatrix <double> m1 = GenerateSparseSystem (size, nEntries);
+            Linear::Matrix <double> rhs = GenerateRandom (size, 1);
+            Linear::SparseLU <double> lu { m1 };
+            Linear::Matrix <double> residual = m1 * lu.Solve (rhs) - rhs;
+
+            for (auto& value : m1.Values ()) {
+                value *= 2;
+            }
+            lu.Refactorize (m1);
+            Linear::Matrix <double> refactorizedResidual = m1 * lu.Solve (rhs) - rhs;
+            Linear::Matrix <double> solverResidual = m1 * Solver { m1, rhs }.Execute ().second - rhs;
+            double maxDifference = 0.0;
+            for (int i = 0; i < size; ++i) {
+                maxDifference = std::max (maxDifference, std::fabs (residual.At (i, 0)));
+                maxDifference = std::max (maxDifference, std::fabs (refactorizedResidual.At (i, 0)));
+                maxDifference = std::max (maxDifference, std::fabs (solverResidual.At (i, 0)));
+            }
+            return maxDifference < EPS;
+        }
+
+        //  CG on a grid Laplacian, GMRES on a nonsymmetric system, both preconditioners
+        bool IterativeTest (int side) {
+            int size = side * side;
+            Linear::SparseMatrix <double> laplacian { size, size };
+            for (int i = 0; i < size; ++i) {
+                laplacian.Add (i, i, 4.1);
+                if (i % side + 1 < side) {
+                    laplacian.Add (i, i + 1, -1.0);
+                    laplacian.Add (i + 1, i, -1.0);
+                }
+                if (i + side < size) {
+                    laplacian.Add (i, i + side, -1.0);
+                    laplacian.Add (i + side, i, -1.0);
+                }
+            }
+            laplacian.Compress ();
+            Linear::SparseMatrix <double> general = GenerateSparseSystem (size, 2 * size);
+            for (int i = 0; i < size; i += 5) {
+                general.Add (i, i, 4.0);
+            }
+            general.Compress ();
+            Linear::Matrix <double> rhs = GenerateRandom (size, 1);
+            std::vector <double> rhsVector (size);
+            for (int i = 0; i < size; ++i) {
+                rhsVector[i] = rhs.At (i, 0);
+            }
+
+            std::vector <Iterative::Result> results {
+                Iterative::CG (laplacian, rhsVector, Iterative::Jacobi { laplacian }),
+                Iterative::CG (laplacian, rhsVector, Iterative::ILU0 { laplacian }),
+                Iterative::GMRES (general, rhsVector, Iterative::Jacobi { general }),
+                Iterative::GMRES (general, rhsVector, Iterative::ILU0 { general })
+            };
+            bool result = true;
+            for (int t = 0; t < static_cast <int> (results.size ()); ++t) {
+                const Linear::SparseMatrix <double>& matrix = (t < 2 ? laplacian : general);
+                std::vector <double> residual = matrix * results[t].solution;
+                for (int i = 0; i < size; ++i) {
+                    result = result && results[t].converged && std::fabs (residual[i] - rhsVector[i]) < EPS;
+                }
+            }
+            return result;
+        }
+
+        //  Fused elementwise chains, an operand that is also the target, products of expressions
+        bool ExpressionTest (int rows, int cols) {
+            Linear::Matrix <double> a = GenerateRandom (rows, cols), b = GenerateRandom (rows, cols), c = GenerateRandom (rows, cols);
+            Linear::Matrix <double> fused = a + b - 2.0 * c;
+            Linear::Matrix <double> aliased = a;
+            aliased = -(aliased - b) * 0.5 + aliased;
+            aliased += a + c;
+            Linear::Matrix <double> square = GenerateRandom (cols, cols);
+            Linear::Matrix <double> sum = a + b;
+            Linear::Matrix <double> fusedProduct = (a + b) * (square - 0.5 * square);
+            Linear::Matrix <double> halfSquare = square;
+            halfSquare *= 0.5;
+            Linear::Matrix <double> correctProduct = sum * halfSquare;
+            double maxDifference = 0.0;
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    double fusedAns = a.At (i, j) + b.At (i, j) - 2.0 * c.At (i, j);
+                    double aliasedAns = -(a.At (i, j) - b.At (i, j)) * 0.5 + a.At (i, j) + a.At (i, j) + c.At (i, j);
+                    maxDifference = std::max (maxDifference, std::fabs (fused.At (i, j) - fusedAns));
+                    maxDifference = std::max (maxDifference, std::fabs (aliased.At (i, j) - aliasedAns));
+                    maxDifference = std::max (maxDifference, std::fabs (fusedProduct.At (i, j) - correctProduct.At (i, j)));
+                }
+            }
+            return maxDifference < EPS;
+        }
+
+        //  Products and determinants of blocks and transposes, appending through views
+        bool ViewTest (int rows, int cols) {
+            Linear::Matrix <double> m = GenerateRandom (rows, cols);
+            Linear::Matrix <double> transposed = m;
+            transposed.Transpose ();
+            auto block = m.View ().Block (1, 1, rows - 2, cols - 2);
+            Linear::Matrix <double> blockCopy { block };
+            double maxDifference = 0.0;
+
+            Linear::Matrix <double> gram = m.View ().Transposed () * m;
+            Linear::Matrix <double> correctGram = transposed * m;
+            Linear::Matrix <double> blockGram = block * block.Transposed ();
+            Linear::Matrix <double> correctBlockGram = blockCopy * Linear::Matrix <double> { blockCopy.View ().Transposed () };
+            for (int i = 0; i < cols; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (gram.At (i, j) - correctGram.At (i, j)));
+                }
+            }
+            for (int i = 0; i < rows - 2; ++i) {
+                for (int j = 0; j < rows - 2; ++j) {
+                    maxDifference = std::max (maxDifference, std::fabs (blockGram.At (i, j) - correctBlockGram.At (i, j)));
+                }
+            }
+
+            //  Zero-copy Laplace must match the Matrix one exactly
+            int size = std::min ({ rows - 2, cols - 2, 7 });
+            auto minor = block.Block (0, 0, size, size);
+            bool result = (Linear::Determinant::Full (minor) == Linear::Matrix <double> { minor }.Determinant (Linear::Determinant::Type::FULL));
+
+            Linear::Matrix <double> appended = m;
+            appended.AppendCols (m, true);
+            appended.View ().ColView (0).Assign (m.View ().ColView (cols - 1));
+            for (int i = 0; i < rows; ++i) {
+                result = result && (appended.At (i, 0) == m.At (i, cols - 1));
+                for (int j = 1; j < 2 * cols; ++j) {
+                    result = result && (appended.At (i, j) == m.At (i, j % cols));
+                }
+            }
+            return result && maxDifference < EPS;
+        }
+
+        //  In place for squares, tiled for rectangles, a reshape for vectors
+        bool TransposeTest (int rows, int cols) {
+            Linear::Matrix <double> m = GenerateRandom (rows, cols);
+            Linear::Matrix <double> transposed = m;
+            transposed.Transpose ();
+            bool result = (transposed == Linear::Matrix <double> { m.View ().Transposed () });
+            transposed.Transpose ();
+            return result && transposed == m;
+        }
+
+        //  A matrix grown row by row and column by column, in front and at the back
+        bool AppendTest (int rows, int cols) {
+            Linear::Matrix <double> m = GenerateRandom (rows, cols);
+            Linear::Matrix <double> byRows { m.View ().Block (0, 0, 1, cols) };
+            for (int i = 1; i < rows; ++i) {
+                byRows.AppendRows (Linear::Matrix <double> { m.View ().RowView (i) });
+            }
+            Linear::Matrix <double> byCols { m.View ().Block (0, cols - 1, rows, 1) };
+            for (int j = cols - 2; j >= 0; --j) {
+                byCols.AppendCols (Linear::Matrix <double> { m.View ().ColView (j) }, true);
+            }
+            //  Geometric growth leaves room for the next rows
+            bool result = (byRows == m && byCols == m && byRows.Capacity () < 2 * m.Size () + cols);
+
+            Linear::Matrix <double> both = m;
+            both.AppendRows (m, true);
+            both.AppendCols (both);
+            for (int i = 0; i < 2 * rows; ++i) {
+                for (int j = 0; j < 2 * cols; ++j) {
+                    result = result && (both.At (i, j) == m.At (i % rows, j % cols));
+                }
+            }
+
+            //  In front of a matrix of another size
+            Linear::Matrix <double> top = GenerateRandom (rows + 2, cols), left = GenerateRandom (rows, cols + 3);
+            Linear::Matrix <double> below = m, right = m;
+            below.AppendRows (top, true);
+            right.AppendCols (left, true);
+            for (int i = 0; i < 2 * rows + 2; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    result = result && (below.At (i, j) == (i < rows + 2 ? top.At (i, j) : m.At (i - rows - 2, j)));
+                }
+            }
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < 2 * cols + 3; ++j) {
+                    result = result && (right.At (i, j) == (j < cols + 3 ? left.At (i, j) : m.At (i, j - cols - 3)));
+                }
+            }
+            return result;
+        }
+
+        //  Random growing and shrinking against a freshly built matrix of the new shape
+        bool ResizeTest (int steps) {
+            std::uniform_int_distribution <> sizes { 0, 30 };
+            Linear::Matrix <double> m = GenerateRandom (5, 5);
+            bool result = true;
+            for (int step = 0; step < steps; ++step) {
+                Linear::PairInt shape { sizes (generator_), sizes (generator_) };
+                Linear::Matrix <double> correct { shape.first, shape.second };
+                int keptRows = std::min (shape.first, m.Shape ().first), keptCols = std::min (shape.second, m.Shape ().second);
+                if (correct.Size () != 0) {
+                    correct.View ().Block (0, 0, keptRows, keptCols).Assign (m.View ().Block (0, 0, keptRows, keptCols));
+                }
+                m.Resize (shape);
+                result = result && (m == correct);
+                m = correct + GenerateRandom (correct.Shape ().first, correct.Shape ().second);
+            }
+
+            //  A table grown one vertex at a time, as the parser does
+            Linear::Matrix <double> table {};
+            for (int i = 1; i <= 200; ++i) {
+                table.Resize ({ i, 1 });
+                table.At (i - 1, 0) = i;
+            }
+            for (int i = 0; i < 200; ++i) {
+                result = result && (table.At (i, 0) == i + 1);
+            }
+            return result && table.Capacity () < 2 * table.Size ();
+        }
+
+        //  A whole solve inside an arena that cannot fall back to the heap, and matrices
+        //  that keep their own resource whatever is assigned to them
+        bool MemoryTest (int size) {
+            Linear::Matrix <double> main = GenerateRandom (size, size), rhs = GenerateRandom (size, 1);
+            PairMatrix heapAns = Solver { main, rhs }.Execute ();
+            std::vector <char> storage (16 * sizeof (double) * size * (size + 1) + 4096);
+            std::pmr::monotonic_buffer_resource arena { storage.data (), storage.size (), std::pmr::null_memory_resource () };
+            std::pmr::memory_resource* heap = std::pmr::get_default_resource ();
+            Linear::Matrix <double> arenaAns {}, movedAns {};
+            bool result = true;
+            {
+                Memory::Scope scope { &arena };
+                PairMatrix ans = Solver { main, rhs }.Execute ();
+                result = result && (ans.second.Resource () == &arena);
+                //  Made outside the scope, so they stay on the heap
+                arenaAns = ans.second;
+                movedAns = std::move (ans.second);
+            }
+            result = result && arenaAns.Resource () == heap && movedAns.Resource () == heap;
+            result = result && arenaAns == heapAns.second && movedAns == heapAns.second;
+
+            //  An explicit resource, kept by copy and move assignment, not by a copy
+            Linear::Matrix <double> inArena { size, size, 0.0, &arena };
+            inArena = main;
+            result = result && inArena.Resource () == &arena && inArena == main;
+            inArena = Linear::Matrix <double> { main };
+            result = result && inArena.Resource () == &arena && inArena == main;
+            inArena.AppendCols (rhs);
+            inArena.Transpose ();
+            result = result && inArena.Resource () == &arena && inArena.At (size, 0) == rhs.At (0, 0);
+            Linear::Matrix <double> copy { inArena }, copyInArena { main, &arena };
+            return result && copy.Resource () == heap && copyInArena.Resource () == &arena && copyInArena == main;
+        }
+
+        //  Aligned padded rows across resizes, appends, transposes and input / output
+        bool LayoutTest (int rows, int cols) {
+            Linear::Matrix <double> m = GenerateRandom (rows, cols);
+            Linear::Matrix <double> correct = m;
+            bool result = true;
+            auto aligned = [] (const Linear::Matrix <double>& matrix) {
+                bool ans = true;
+                for (int i = 0; i < matrix.Shape ().first && matrix.LeadingDimension () != matrix.Shape ().second; ++i) {
+                    ans = ans && (reinterpret_cast <std::uintptr_t> (matrix.Row (i)) % MATRIX_ALIGNMENT == 0);
+                }
+                return ans;
+            };
+            result = result && aligned (m);
+
+            //  Across the padding threshold and back
+            m.Resize ({ rows, 2 * cols });
+            result = result && aligned (m);
+            m.Resize ({ rows, cols });
+            result = result && (m == correct);
+            m.AppendCols (m);
+            m.AppendRows (Linear::Matrix <double> { 1, 2 * cols, 1.0 });
+            result = result && aligned (m) && m.At (rows, 2 * cols - 1) == 1.0 && m.At (rows - 1, 2 * cols - 1) == correct.At (rows - 1, cols - 1);
+
+            Linear::Matrix <double> row { m.View ().RowView (rows - 1) };
+            row.Transpose ();
+            row.Transpose ();
+            result = result && (row == Linear::Matrix <double> { m.View ().RowView (rows - 1) });
+
+            std::stringstream stream {};
+            stream << correct.Shape ().first << " " << correct.Shape ().second;
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    stream << " " << std::setprecision (17) << correct.At (i, j);
+                }
+            }
+            Linear::Matrix <double> read {};
+            stream >> read;
+            return result && read == correct;
+        }
+
+        //  Fixed size results match Matrix ones, and computing them never allocates
+        template <int N>
+        bool FixedTest () {
+            Linear::Matrix <double> a = GenerateRandom (N, N), b = GenerateRandom (N, N);
+            a += Linear::Matrix <double>::Eye (N);
+            Linear::FixedMatrix <double, N, N> fa { a }, fb { b }, product {}, inverse {};
+            double determinant = 0;
+            {
+                Memory::Scope scope { std::pmr::null_memory_resource () };
+                product = fa * fb - 2.0 * fb.Transposed ();
+                determinant = fa.Determinant ();
+                inverse = fa.Inverse ();
+            }
+            static_assert (Linear::FixedMatrix <int, 2, 2> { { 1, 2, 3, 4 } }.Determinant () == -2);
+            static_assert (Linear::FixedMatrix <double, 2, 2> { { 4, 3, 1, 1 } }.Inverse () == Linear::FixedMatrix <double, 2, 2> { { 1, -3, -1, 4 } });
+            Linear::Matrix <double> correct = a * b - 2.0 * Linear::Matrix <double> { b.View ().Transposed () };
+            Linear::Matrix <double> identity = a * Linear::Matrix <double> { inverse };
+            bool result = std::fabs (determinant - Linear::Determinant::Gauss (a)) < EPS;
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j) {
+                    result = result && std::fabs (product (i, j) - correct.At (i, j)) < EPS;
+                    result = result && std::fabs (identity.At (i, j) - (i == j ? 1.0 : 0.0)) < EPS;
+                }
+            }
+            return result;
+        }
+
+        //  Exact determinants: Bareiss against Laplace expansion, and against a known product
+        //  of pivots too large for long long
+        bool BareissTest (int size) {
+            std::uniform_int_distribution <long long> element { -9, 9 }, unit { -1, 1 };
+            Linear::Matrix <long long> small { 7 }, medium { 12 };
+            Linear::Matrix <Linear::BigInt> mediumBig { 12 };
+            for (int i = 0; i < 12; ++i) {
+                for (int j = 0; j < 12; ++j) {
+                    medium.At (i, j) = element (generator_);
+                    mediumBig.At (i, j) = medium.At (i, j);
+                    if (i < 7 && j < 7) {
+                        small.At (i, j) = element (generator_);
+                    }
+                }
+            }
+            bool result = (Linear::Determinant::Bareiss (small) == small.Determinant (Linear::Determinant::Type::FULL));
+            //  Above DETERMINANT_LAPLACE_MAX_SIZE Full is Bareiss, so it is checked against the expansion
+            long long laplace = Linear::Determinant::FullMasks (medium.View ());
+            result = result && (Linear::Determinant::Full (medium) == laplace) && (Linear::Determinant::Full (mediumBig) == Linear::BigInt { laplace });
+
+            //  L * U with a unit lower L and 3 or -3 on the diagonal of U
+            Linear::Matrix <long long> lower { size }, upper { size };
+            Linear::BigInt expected = 1;
+            for (int i = 0; i < size; ++i) {
+                lower.At (i, i) = 1;
+                upper.At (i, i) = (unit (generator_) < 0 ? -3 : 3);
+                expected *= upper.At (i, i);
+                for (int j = 0; j < i; ++j) {
+                    lower.At (i, j) = unit (generator_);
+                    upper.At (j, i) = unit (generator_);
+                }
+            }
+            Linear::Matrix <long long> product = lower * upper;
+            Linear::Matrix <Linear::BigInt> productBig { size };
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    productBig.At (i, j) = product.At (i, j);
+                }
+            }
+            result = result && (productBig.Determinant (Linear::Determinant::Type::BAREISS) == expected);
+            try {
+                Linear::Determinant::Bareiss (product);
+                result = false;
+            }
+            catch (std::overflow_error& ex) {}
+
+            //  Text round trip, and division exact on multi-limb values
+            Linear::BigInt power = 1, factor { "-123456789012345678901" };
+            for (int i = 0; i < 50; ++i) {
+                power *= 3;
+            }
+            result = result && power.ToString () == "717897987691852588770249" && Linear::BigInt { power.ToString () } == power;
+            result = result && (power * factor - 7) / factor == power && (power * factor - 7) % factor == -7 && -power < factor;
+            return result;
+        }
+
+        //  Laplace expansion over a ring without division: unsigned arithmetic is exact
+        //  modulo 2^64, so it has to agree with the exact determinant reduced the same way
+        bool RingDeterminantTest (int size) {
+            std::uniform_int_distribution <long long> element { -9, 9 };
+            Linear::Matrix <unsigned long long> ring { size };
+            Linear::Matrix <Linear::BigInt> exact { size };
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    long long value = element (generator_);
+                    ring.At (i, j) = static_cast <unsigned long long> (value);
+                    exact.At (i, j) = value;
+                }
+            }
+            Linear::BigInt modulus { "18446744073709551616" };
+            Linear::BigInt reduced = Linear::Determinant::Bareiss (exact) % modulus;
+            if (reduced < 0) {
+                reduced += modulus;
+            }
+            return Linear::BigInt { std::to_string (Linear::Determinant::Full (ring)) } == reduced;
+        }
+
+        //  The minor table of Full split between the workers of a pool of its own equals the
+        //  sequential one, below and above DETERMINANT_PARALLEL_SIZE
+        bool ParallelDeterminantTest (int size) {
+            Parallel::ThreadPool pool { PARALLEL_TEST_THREADS };
+            std::uniform_int_distribution <long long> element { -9, 9 };
+            Linear::Matrix <unsigned long long> ring { size };
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    ring.At (i, j) = static_cast <unsigned long long> (element (generator_));
+                }
+            }
+            auto run = [&] (Parallel::Policy policy) {
+                Parallel::Scope scope { policy, pool };
+                return Linear::Determinant::Full (ring);
+            };
+            return run (Parallel::Policy::SEQUENTIAL) == run (Parallel::Policy::PARALLEL);
+        }
+
+        //  Every operation taking a policy gives the same bits under both policies. The parallel
+        //  runs use a pool of their own with PARALLEL_TEST_THREADS workers, so they are split
+        //  even where the shared pool has none
+        bool ParallelTest (int rows, int cols) {
+            Parallel::ThreadPool pool { PARALLEL_TEST_THREADS };
+            Linear::Matrix <double> a = GenerateRandom (rows, cols), b = GenerateRandom (cols, rows), square = GenerateRandom (cols, cols);
+            auto run = [&] (Parallel::Policy policy) {
+                Parallel::Scope scope { policy, pool };
+                std::vector <Linear::Matrix <double>> ans {};
+                ans.push_back (a * b);
+                ans.push_back (2.0 * a - Linear::Matrix <double> { b.View ().Transposed () });
+                ans.push_back (a);
+                ans.back ().Transpose (policy);
+                ans.push_back (square);
+                ans.back ().Transpose (policy);
+                ans.push_back (square);
+                ans.back ().DirectGauss (nullptr, policy);
+                ans.push_back (Linear::Matrix <double> { 1, 1, static_cast <double> (ans[0].Equals (a * b, policy)) });
+                return ans;
+            };
+            std::vector <Linear::Matrix <double>> sequential = run (Parallel::Policy::SEQUENTIAL);
+            std::vector <Linear::Matrix <double>> parallel = run (Parallel::Policy::PARALLEL);
+            bool result = (sequential.back ().At (0, 0) == 1.0);
+            for (int i = 0; i < static_cast <int> (sequential.size ()); ++i) {
+                result = result && (sequential[i] == parallel[i]);
+            }
+            Linear::Matrix <double> transposed = square;
+            {
+                Parallel::Scope scope { Parallel::Policy::PARALLEL, pool };
+                result = result && (Parallel::Splits (Parallel::Policy::PARALLEL, PARALLEL_MIN_WORK));
+                transposed.Transpose (Parallel::Policy::PARALLEL);
+            }
+            for (int i = 0; i < cols; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    result = result && (transposed.At (i, j) == square.At (j, i));
+                }
+            }
+
+            //  Nested loops of uneven length run every index once, and an exception comes back
+            std::vector <std::atomic <int>> hits (rows * cols);
+            pool.ParallelFor (0, rows, 1, [&] (int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    pool.ParallelFor (0, (i % 3 == 0 ? cols : 1), 1, [&] (int first, int last) {
+                        for (int j = first; j < last; ++j) {
+                            ++hits[i * cols + j];
+                        }
+                    });
+                }
+            });
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    result = result && (hits[i * cols + j] == (i % 3 == 0 || j == 0 ? 1 : 0));
+                }
+            }
+            try {
+                pool.ParallelFor (0, rows, 1, [&] (int begin, int end) {
+                    if (begin <= rows / 2 && rows / 2 < end) {
+                        throw std::runtime_error ("Chunk failed");
+                    }
+                });
+                result = false;
+            }
+            catch (std::runtime_error& ex) {}
+            return result;
+        }
+
+        //  One factorization of a rank-deficient main for a block of right-hand sides
+        //  and then for each of them alone, and an inconsistent one rejected
+        bool RightHandSidesTest (int rows, int cols, int rank, int nRhs, double scale = 1.0) {
+            Linear::Matrix <double> main = scale * (GenerateRandom (rows, rank) * GenerateRandom (rank, cols));
+            Linear::Matrix <double> rhs = main * GenerateRandom (cols, nRhs);
+            Solver solver { main };
+            PairMatrix block = solver.Solve (rhs);
+            bool result = (solver.Rank () == rank) && (block.first.Shape ().second == cols - rank);
+            Linear::Matrix <double> residual = main * block.second - rhs;
+            Linear::Matrix <double> kernel = (cols > rank ? main * block.first : Linear::Matrix <double> {});
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < nRhs; ++j) {
+                    result = result && std::fabs (residual.At (i, j)) < EPS;
+                }
+                for (int j = 0; j < cols - rank; ++j) {
+                    result = result && std::fabs (kernel.At (i, j)) < EPS;
+                }
+            }
+            for (int j = 0; j < nRhs; ++j) {
+                Linear::Matrix <double> column { rows, 1 };
+                for (int i = 0; i < rows; ++i) {
+                    column.At (i, 0) = rhs.At (i, j);
+                }
+                PairMatrix single = solver.Solve (column);
+                for (int i = 0; i < cols; ++i) {
+                    result = result && std::fabs (single.second.At (i, 0) - block.second.At (i, j)) < EPS;
+                }
+            }
+            Linear::Matrix <double> outside = GenerateRandom (rows, 1);
+            try {
+                solver.Solve (outside);
+                result = result && (rank == rows);
+            }
+            catch (std::invalid_argument& ex) {
+                result = result && (rank < rows);
+            }
+            return result;
+        }
+
+        //  Every system of a batch against its own LU, one of them singular
+        bool BatchTest (int size, int count, int nRhs) {
+            std::vector <Linear::Matrix <double>> mains {}, rhss {};
+            for (int s = 0; s < count; ++s) {
+                mains.push_back (GenerateRandom (size, size));
+                rhss.push_back (GenerateRandom (size, nRhs));
+            }
+            //  One singular system in the middle of the batch
+            for (int j = 0; j < size; ++j) {
+                mains[count / 2].At (size - 1, j) = (size > 1 ? 2 * mains[count / 2].At (0, j) : 0);
+            }
+            //  And one regular system with small entries, like the conductances of kOhm resistors
+            const double small = 1e-4;
+            int scaled = count - 1;
+            std::vector <Linear::Matrix <double>> systems = mains;
+            systems[scaled] = small * mains[scaled];
+            BatchSolver solver { size, BatchSolver::Interleave (systems) };
+            Linear::Matrix <double> answers = solver.Solve (BatchSolver::Interleave (rhss), nRhs);
+            bool result = solver.Singular (count / 2) && std::isnan (answers.At (0, count / 2));
+            for (int s = 0; s < count; ++s) {
+                if (s == count / 2) {
+                    continue;
+                }
+                Linear::Matrix <double> correct = mains[s].Factorize ().Solve (rhss[s]);
+                Linear::Matrix <double> answer = BatchSolver::Extract (answers, size, nRhs, s);
+                double unscale = (s == scaled ? small : 1.0);
+                result = result && !solver.Singular (s);
+                for (int i = 0; i < size; ++i) {
+                    for (int j = 0; j < nRhs; ++j) {
+                        result = result && std::fabs (unscale * answer.At (i, j) - correct.At (i, j)) < EPS;
+                    }
+                }
+            }
+            return result;
+        }
+
+        //  A ring of vertices with random chords, random resistors and sources, and one ideal
+        //  source (zero resistance) if withIdeal: loop and nodal analysis give the same currents
+        bool CircuitTest (int nVertices, int nChords, bool withIdeal) {
+            std::uniform_int_distribution <> vertexDistribution { 0, nVertices - 1 };
+            std::uniform_real_distribution <> resistanceDistribution { 1.0, 10.0 };
+            Linear::SparseMatrix <RV> table { nVertices, nVertices };
+            std::set <Edge> edges {};
+            auto connect = [&] (Vertex from, Vertex to, RV rv) {
+                if (from == to || edges.count ({ from, to }) || edges.count ({ to, from })) {
+                    return;
+                }
+                edges.insert ({ from, to });
+                table.Insert (from, to) = rv;
+                table.Insert (to, from) = RV { rv.Resistance (), -rv.Voltage () };
+            };
+            if (withIdeal) {
+                connect (0, nVertices / 2, RV { 0.0, 5.0 });
+            }
+            for (int i = 0; i < nVertices; ++i) {
+                connect (i, (i + 1) % nVertices, RV { resistanceDistribution (generator_), 10 * uniformDistribution_ (generator_) });
+            }
+            for (int t = 0; t < nChords; ++t) {
+                connect (vertexDistribution (generator_), vertexDistribution (generator_), RV { resistanceDistribution (generator_), 0.0 });
+            }
+            table.Compress (Linear::SparseMatrix <RV>::Duplicates::LAST);
+            Circuit circuit { table };
+            Linear::Matrix <double> loop = circuit.Currents (Circuit::Mode::LOOP);
+            Linear::Matrix <double> nodal = circuit.Currents (Circuit::Mode::NODAL);
+            Linear::Matrix <double> iterative = circuit.Currents (Circuit::Mode::NODAL_ITERATIVE);
+            double maxDifference = 0.0;
+            for (int i = 0; i < loop.Shape ().first; ++i) {
+                maxDifference = std::max (maxDifference, std::fabs (loop.At (i, 0) - nodal.At (i, 0)));
+                maxDifference = std::max (maxDifference, std::fabs (loop.At (i, 0) - iterative.At (i, 0)));
+            }
+            //  KCL and KVL together give one equation per edge, in every circuit of the process
+            int nEdges = edges.size ();
+            Linear::PairInt square { nEdges, nEdges };
+            bool result = (circuit.Execute ().first.Shape () == square) && (loop.Shape ().first == nEdges);
+            return result && (loop.Shape () == nodal.Shape ()) && (loop.Shape () == iterative.Shape ()) && (maxDifference < EPS);
+        }
+
     public:
         void Execute () {
             std::cerr << "----------------------------------" << std::endl;
@@ -142,5 +884,83 @@ class Generator {
                 std::cout << std::boolalpha << GivenDeterminantTest (std::fabs (uniformDistribution_ (generator_))) << std::endl;
             }
             std::cout << std::boolalpha << GivenDeterminantTest (42) << std::endl;
+            std::cout << std::boolalpha << BareissTest (50) << std::endl;
+            std::cout << std::boolalpha << RingDeterminantTest (5) << std::endl;
+            std::cout << std::boolalpha << RingDeterminantTest (20) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "MULTIPLICATION TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << MultiplyTest (7, 5, 3) << std::endl;
+            std::cout << std::boolalpha << MultiplyTest (97, 131, 61) << std::endl;
+            std::cout << std::boolalpha << MultiplyTest (300, 257, 301) << std::endl;
+            std::cout << std::boolalpha << ExpressionTest (1, 1) << std::endl;
+            std::cout << std::boolalpha << ExpressionTest (37, 53) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "PARALLEL TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << ParallelTest (5, 3) << std::endl;
+            std::cout << std::boolalpha << ParallelTest (301, 517) << std::endl;
+            std::cout << std::boolalpha << ParallelDeterminantTest (DETERMINANT_PARALLEL_SIZE - 4) << std::endl;
+            std::cout << std::boolalpha << ParallelDeterminantTest (DETERMINANT_PARALLEL_SIZE + 2) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "FACTORIZATION TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            for (int i = 0; i < 5; ++i) {
+                std::cout << std::boolalpha << FactorizationTest () << std::endl;
+            }
+            std::cout << std::boolalpha << QRTest (1, 1, 1, 1.0) << std::endl;
+            std::cout << std::boolalpha << QRTest (40, 70, 23, 1e-6) << std::endl;
+            std::cout << std::boolalpha << QRTest (150, 100, 99, 1e6) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "SPARSE TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << SparseTest (1, 1, 3) << std::endl;
+            std::cout << std::boolalpha << SparseTest (40, 30, 100) << std::endl;
+            std::cout << std::boolalpha << SparseTest (200, 200, 1000) << std::endl;
+            std::cout << std::boolalpha << SparseSolveTest (10, 5) << std::endl;
+            std::cout << std::boolalpha << SparseSolveTest (500, 1000) << std::endl;
+            std::cout << std::boolalpha << SparseSolveTest (2000, 4000) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "ITERATIVE TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << IterativeTest (3) << std::endl;
+            std::cout << std::boolalpha << IterativeTest (40) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "RIGHT-HAND SIDES TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << RightHandSidesTest (5, 5, 5, 4) << std::endl;
+            std::cout << std::boolalpha << RightHandSidesTest (40, 30, 17, 6) << std::endl;
+            std::cout << std::boolalpha << RightHandSidesTest (20, 45, 12, 3) << std::endl;
+            std::cout << std::boolalpha << RightHandSidesTest (30, 30, 20, 2, 1e-5) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "BATCH TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << BatchTest (1, 3, 1) << std::endl;
+            std::cout << std::boolalpha << BatchTest (10, 100, 1) << std::endl;
+            std::cout << std::boolalpha << BatchTest (37, 21, 3) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "CIRCUIT TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << CircuitTest (3, 0, false) << std::endl;
+            std::cout << std::boolalpha << CircuitTest (30, 40, false) << std::endl;
+            std::cout << std::boolalpha << CircuitTest (200, 300, true) << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cerr << "VIEW TESTS" << std::endl;
+            std::cerr << "----------------------------------" << std::endl;
+            std::cout << std::boolalpha << ViewTest (3, 3) << std::endl;
+            std::cout << std::boolalpha << ViewTest (61, 47) << std::endl;
+            std::cout << std::boolalpha << TransposeTest (1, 7) << std::endl;
+            std::cout << std::boolalpha << TransposeTest (97, 1) << std::endl;
+            std::cout << std::boolalpha << TransposeTest (100, 100) << std::endl;
+            std::cout << std::boolalpha << TransposeTest (65, 130) << std::endl;
+            std::cout << std::boolalpha << AppendTest (1, 1) << std::endl;
+            std::cout << std::boolalpha << AppendTest (50, 40) << std::endl;
+            std::cout << std::boolalpha << ResizeTest (100) << std::endl;
+            std::cout << std::boolalpha << MemoryTest (30) << std::endl;
+            std::cout << std::boolalpha << LayoutTest (3, 70) << std::endl;
+            std::cout << std::boolalpha << LayoutTest (45, 37) << std::endl;
+            std::cout << std::boolalpha << FixedTest <2> () << std::endl;
+            std::cout << std::boolalpha << FixedTest <3> () << std::endl;
+            std::cout << std::boolalpha << FixedTest <4> () << std::endl;
         }
 };
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "BigInt.hpp"
+
+//	SYSTEM
+#include <algorithm>
+#include <stdexcept>
+#include <cctype>
+
+namespace {
+	const uint64_t LIMB_BASE = uint64_t { 1 } << 32;
+	//	Largest power of ten in a limb, decimal conversion goes nine digits at a time
+	const uint32_t DECIMAL_CHUNK = 1000000000;
+	const int DECIMAL_CHUNK_DIGITS = 9;
+
+	//	magnitude = magnitude * factor + addend
+	void MultiplyAddSmall (std::vector <uint32_t>& magnitude, uint32_t factor, uint32_t addend) {
+		uint64_t carry = addend;
+		for (uint32_t& limb : magnitude) {
+			uint64_t current = uint64_t { limb } * factor + carry;
+			limb = static_cast <uint32_t> (current);
+			carry = current >> 32;
+		}
+		if (carry) {
+			magnitude.push_back (static_cast <uint32_t> (carry));
+		}
+	}
+
+	//	magnitude /= divisor, returns the remainder
+	uint32_t DivideSmall (std::vector <uint32_t>& magnitude, uint32_t divisor) {
+		uint64_t remainder = 0;
+		for (int i = static_cast <int> (magnitude.size ()) - 1; i >= 0; --i) {
+			uint64_t current = (remainder << 32) | magnitude[i];
+			magnitude[i] = static_cast <uint32_t> (current / divisor);
+			remainder = current % divisor;
+		}
+		while (!magnitude.empty () && magnitude.back () == 0) {
+			magnitude.pop_back ();
+		}
+		return static_cast <uint32_t> (remainder);
+	}
+}
+
+Linear::BigInt::BigInt (long long value):
+	negative_ (value < 0)
+	{
+		//	Through unsigned, so that the smallest long long does not overflow
+		uint64_t magnitude = (value < 0 ? uint64_t { 0 } - static_cast <uint64_t> (value) : static_cast <uint64_t> (value));
+		while (magnitude) {
+			limbs_.push_back (static_cast <uint32_t> (magnitude));
+			magnitude >>= 32;
+		}
+	}
+
+Linear::BigInt::BigInt (const std::string& digits) {
+	int start = (!digits.empty () && (digits[0] == '-' || digits[0] == '+') ? 1 : 0);
+	if (start == static_cast <int> (digits.size ())) {
+		throw (std::invalid_argument ("Wrong integer: \"" + digits + "\"."));
+	}
+	for (int i = start; i < static_cast <int> (digits.size ()); ++i) {
+		if (!std::isdigit (static_cast <unsigned char> (digits[i]))) {
+			throw (std::invalid_argument ("Wrong integer: \"" + digits + "\"."));
+		}
+		MultiplyAddSmall (limbs_, 10, digits[i] - '0');
+	}
+	Trim ();
+	negative_ = (digits[0] == '-' && !limbs_.empty ());
+}
+
+void Linear::BigInt::Trim () {
+	while (!limbs_.empty () && limbs_.back () == 0) {
+		limbs_.pop_back ();
+	}
+	if (limbs_.empty ()) {
+		negative_ = false;
+	}
+}
+
+int Linear::BigInt::CompareMagnitude (const std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs) {
+	if (lhs.size () != rhs.size ()) {
+		return (lhs.size () < rhs.size () ? -1 : 1);
+	}
+	for (int i = static_cast <int> (lhs.size ()) - 1; i >= 0; --i) {
+		if (lhs[i] != rhs[i]) {
+			return (lhs[i] < rhs[i] ? -1 : 1);
+		}
+	}
+	return 0;
+}
+
+void Linear::BigInt::AddMagnitude (std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs) {
+	if (lhs.size () < rhs.size ()) {
+		lhs.resize (rhs.size (), 0);
+	}
+	uint64_t carry = 0;
+	for (size_t i = 0; i < lhs.size (); ++i) {
+		uint64_t current = uint64_t { lhs[i] } + (i < rhs.size () ? rhs[i] : 0) + carry;
+		lhs[i] = static_cast <uint32_t> (current);
+		carry = current >> 32;
+		if (!carry && i >= rhs.size ()) {
+			break;
+		}
+	}
+	if (carry) {
+		lhs.push_back (static_cast <uint32_t> (carry));
+	}
+}
+
+void Linear::BigInt::SubtractMagnitude (std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs) {
+	int64_t borrow = 0;
+	for (size_t i = 0; i < lhs.size (); ++i) {
+		int64_t current = int64_t { lhs[i] } - (i < rhs.size () ? rhs[i] : 0) - borrow;
+		borrow = (current < 0 ? 1 : 0);
+		lhs[i] = static_cast <uint32_t> (current + (borrow ? LIMB_BASE : 0));
+		if (!borrow && i >= rhs.size ()) {
+			break;
+		}
+	}
+	while (!lhs.empty () && lhs.back () == 0) {
+		lhs.pop_back ();
+	}
+}
+
+std::vector <uint32_t> Linear::BigInt::MultiplyMagnitude (const std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs) {
+	if (lhs.empty () || rhs.empty ()) {
+		return {};
+	}
+	std::vector <uint32_t> ans (lhs.size () + rhs.size (), 0);
+	for (size_t i = 0; i < lhs.size (); ++i) {
+		uint64_t carry = 0;
+		for (size_t j = 0; j < rhs.size (); ++j) {
+			uint64_t current = uint64_t { lhs[i] } * rhs[j] + ans[i + j] + carry;
+			ans[i + j] = static_cast <uint32_t> (current);
+			carry = current >> 32;
+		}
+		ans[i + rhs.size ()] = static_cast <uint32_t> (carry);
+	}
+	while (!ans.empty () && ans.back () == 0) {
+		ans.pop_back ();
+	}
+	return ans;
+}
+
+std::vector <uint32_t> Linear::BigInt::DivideMagnitude (const std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs,
+														std::vector <uint32_t>& remainder) {
+	if (rhs.empty ()) {
+		throw (std::domain_error ("Division by zero."));
+	}
+	if (CompareMagnitude (lhs, rhs) < 0) {
+		remainder = lhs;
+		return {};
+	}
+	if (rhs.size () == 1) {
+		std::vector <uint32_t> quotient = lhs;
+		uint32_t rest = DivideSmall (quotient, rhs[0]);
+		remainder = (rest ? std::vector <uint32_t> { rest } : std::vector <uint32_t> {});
+		return quotient;
+	}
+
+	//	Long division (Knuth, TAOCP vol. 2, 4.3.1, algorithm D). Both operands are shifted
+	//	so that the top limb of the divisor has its high bit set, then every quotient limb
+	//	estimated from the top two limbs is off by at most two.
+	int n = rhs.size (), m = lhs.size () - n;
+	int shift = __builtin_clz (rhs.back ());
+	std::vector <uint32_t> v (n), u (lhs.size () + 1);
+	for (int i = n - 1; i > 0; --i) {
+		v[i] = (rhs[i] << shift) | (shift ? static_cast <uint32_t> (uint64_t { rhs[i - 1] } >> (32 - shift)) : 0);
+	}
+	v[0] = rhs[0] << shift;
+	u[lhs.size ()] = (shift ? static_cast <uint32_t> (uint64_t { lhs.back () } >> (32 - shift)) : 0);
+	for (int i = lhs.size () - 1; i > 0; --i) {
+		u[i] = (lhs[i] << shift) | (shift ? static_cast <uint32_t> (uint64_t { lhs[i - 1] } >> (32 - shift)) : 0);
+	}
+	u[0] = lhs[0] << shift;
+
+	std::vector <uint32_t> quotient (m + 1, 0);
+	for (int j = m; j >= 0; --j) {
+		uint64_t top = (uint64_t { u[j + n] } << 32) | u[j + n - 1];
+		uint64_t qHat = top / v[n - 1], rHat = top % v[n - 1];
+		while (qHat >= LIMB_BASE || qHat * v[n - 2] > ((rHat << 32) | u[j + n - 2])) {
+			--qHat;
+			rHat += v[n - 1];
+			if (rHat >= LIMB_BASE) {
+				break;
+			}
+		}
+		//	u[j .. j + n] -= qHat * v
+		int64_t borrow = 0, current = 0;
+		for (int i = 0; i < n; ++i) {
+			uint64_t product = qHat * v[i];
+			current = int64_t { u[i + j] } - borrow - static_cast <int64_t> (product & 0xFFFFFFFF);
+			u[i + j] = static_cast <uint32_t> (current);
+			borrow = static_cast <int64_t> (product >> 32) - (current >> 32);
+		}
+		current = int64_t { u[j + n] } - borrow;
+		u[j + n] = static_cast <uint32_t> (current);
+		quotient[j] = static_cast <uint32_t> (qHat);
+		if (current < 0) {
+			//	qHat was one too large: add v back
+			--quotient[j];
+			uint64_t carry = 0;
+			for (int i = 0; i < n; ++i) {
+				uint64_t sum = uint64_t { u[i + j] } + v[i] + carry;
+				u[i + j] = static_cast <uint32_t> (sum);
+				carry = sum >> 32;
+			}
+			u[j + n] += static_cast <uint32_t> (carry);
+		}
+	}
+
+	remainder.assign (n, 0);
+	for (int i = 0; i < n; ++i) {
+		remainder[i] = (u[i] >> shift) | (shift ? static_cast <uint32_t> (uint64_t { u[i + 1] } << (32 - shift)) : 0);
+	}
+	while (!remainder.empty () && remainder.back () == 0) {
+		remainder.pop_back ();
+	}
+	while (!quotient.empty () && quotient.back () == 0) {
+		quotient.pop_back ();
+	}
+	return quotient;
+}
+
+void Linear::BigInt::Add (const BigInt& rhs, bool rhsNegative) {
+	if (negative_ == rhsNegative) {
+		AddMagnitude (limbs_, rhs.limbs_);
+	}
+	else if (CompareMagnitude (limbs_, rhs.limbs_) >= 0) {
+		SubtractMagnitude (limbs_, rhs.limbs_);
+	}
+	else {
+		std::vector <uint32_t> magnitude = rhs.limbs_;
+		SubtractMagnitude (magnitude, limbs_);
+		limbs_.swap (magnitude);
+		negative_ = rhsNegative;
+	}
+	Trim ();
+}
+
+Linear::BigInt& Linear::BigInt::operator += (const BigInt& rhs) {
+	Add (rhs, rhs.negative_);
+	return *this;
+}
+
+Linear::BigInt& Linear::BigInt::operator -= (const BigInt& rhs) {
+	Add (rhs, !rhs.negative_ && !rhs.limbs_.empty ());
+	return *this;
+}
+
+Linear::BigInt& Linear::BigInt::operator *= (const BigInt& rhs) {
+	limbs_ = MultiplyMagnitude (limbs_, rhs.limbs_);
+	negative_ = (negative_ != rhs.negative_);
+	Trim ();
+	return *this;
+}
+
+Linear::BigInt& Linear::BigInt::operator /= (const BigInt& rhs) {
+	std::vector <uint32_t> remainder {};
+	limbs_ = DivideMagnitude (limbs_, rhs.limbs_, remainder);
+	negative_ = (negative_ != rhs.negative_);
+	Trim ();
+	return *this;
+}
+
+Linear::BigInt& Linear::BigInt::operator %= (const BigInt& rhs) {
+	std::vector <uint32_t> remainder {};
+	DivideMagnitude (limbs_, rhs.limbs_, remainder);
+	limbs_.swap (remainder);
+	Trim ();
+	return *this;
+}
+
+Linear::BigInt Linear::BigInt::operator - () const {
+	BigInt ans { *this };
+	ans.negative_ = !negative_ && !limbs_.empty ();
+	return ans;
+}
+
+int Linear::BigInt::Sign () const {
+	return (limbs_.empty () ? 0 : (negative_ ? -1 : 1));
+}
+
+std::string Linear::BigInt::ToString () const {
+	if (limbs_.empty ()) {
+		return "0";
+	}
+	std::vector <uint32_t> magnitude = limbs_;
+	std::string ans {};
+	while (!magnitude.empty ()) {
+		uint32_t chunk = DivideSmall (magnitude, DECIMAL_CHUNK);
+		for (int i = 0; i < DECIMAL_CHUNK_DIGITS && (chunk || !magnitude.empty ()); ++i) {
+			ans.push_back ('0' + chunk % 10);
+			chunk /= 10;
+		}
+	}
+	if (negative_) {
+		ans.push_back ('-');
+	}
+	std::reverse (ans.begin (), ans.end ());
+	return ans;
+}
+
+Linear::BigInt Linear::operator + (const BigInt& lhs, const BigInt& rhs) {
+	BigInt ans { lhs };
+	return ans += rhs;
+}
+
+Linear::BigInt Linear::operator - (const BigInt& lhs, const BigInt& rhs) {
+	BigInt ans { lhs };
+	return ans -= rhs;
+}
+
+Linear::BigInt Linear::operator * (const BigInt& lhs, const BigInt& rhs) {
+	BigInt ans { lhs };
+	return ans *= rhs;
+}
+
+Linear::BigInt Linear::operator / (const BigInt& lhs, const BigInt& rhs) {
+	BigInt ans { lhs };
+	return ans /= rhs;
+}
+
+Linear::BigInt Linear::operator % (const BigInt& lhs, const BigInt& rhs) {
+	BigInt ans { lhs };
+	return ans %= rhs;
+}
+
+bool Linear::operator == (const BigInt& lhs, const BigInt& rhs) {
+	return lhs.negative_ == rhs.negative_ && lhs.limbs_ == rhs.limbs_;
+}
+
+bool Linear::operator != (const BigInt& lhs, const BigInt& rhs) {
+	return !(lhs == rhs);
+}
+
+bool Linear::operator < (const BigInt& lhs, const BigInt& rhs) {
+	if (lhs.negative_ != rhs.negative_) {
+		return lhs.negative_;
+	}
+	int compare = BigInt::CompareMagnitude (lhs.limbs_, rhs.limbs_);
+	return (lhs.negative_ ? compare > 0 : compare < 0);
+}
+
+bool Linear::operator > (const BigInt& lhs, const BigInt& rhs) {
+	return rhs < lhs;
+}
+
+bool Linear::operator <= (const BigInt& lhs, const BigInt& rhs) {
+	return !(rhs < lhs);
+}
+
+bool Linear::operator >= (const BigInt& lhs, const BigInt& rhs) {
+	return !(lhs < rhs);
+}
+
+std::istream& Linear::operator >> (std::istream& stream, BigInt& rhs) {
+	std::string digits {};
+	if (stream >> digits) {
+		try {
+			rhs = BigInt { digits };
+		}
+		catch (std::invalid_argument& ex) {
+			stream.setstate (std::ios::failbit);
+		}
+	}
+	return stream;
+}
+
+std::ostream& Linear::operator << (std::ostream& stream, const BigInt& rhs) {
+	return stream << rhs.ToString ();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+//	SYSTEM
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Linear {
+	//	Arbitrary-precision signed integer, the exact element type for Determinant::Bareiss.
+	//	The magnitude is kept in base 2^32 limbs, least significant first, without leading
+	//	zero limbs, so zero has no limbs. Division truncates toward zero, as for int.
+	class BigInt final {
+		private:
+			//	DATA
+			std::vector <uint32_t> limbs_ {};
+			bool negative_ = false;
+
+			//	AUXILIARY METHODS
+			void Trim ();
+			static int 						CompareMagnitude 	(const std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs);
+			static void 					AddMagnitude 		(std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs);
+			//	lhs -= rhs, |lhs| >= |rhs|
+			static void 					SubtractMagnitude 	(std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs);
+			static std::vector <uint32_t> 	MultiplyMagnitude 	(const std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs);
+			//	Quotient of the magnitudes, the remainder goes to remainder
+			static std::vector <uint32_t> 	DivideMagnitude 	(const std::vector <uint32_t>& lhs, const std::vector <uint32_t>& rhs,
+																 std::vector <uint32_t>& remainder);
+			//	Signed sum, rhsNegative is the sign rhs is taken with
+			void 							Add 				(const BigInt& rhs, bool rhsNegative);
+		public:
+			//	CTORS
+			BigInt () = default;
+			BigInt (long long value);
+			explicit BigInt (const std::string& digits);
+
+			//	OVERLOADED OPERATORS
+			BigInt& operator += (const BigInt& rhs);
+			BigInt& operator -= (const BigInt& rhs);
+			BigInt& operator *= (const BigInt& rhs);
+			BigInt& operator /= (const BigInt& rhs);
+			BigInt& operator %= (const BigInt& rhs);
+			BigInt 	operator - 	() const;
+
+			//	GETTERS
+			//	-1, 0 or 1
+			int 		Sign 		() const;
+			std::string ToString 	() const;
+
+			friend bool operator == (const BigInt& lhs, const BigInt& rhs);
+			friend bool operator < 	(const BigInt& lhs, const BigInt& rhs);
+	};
+
+	//	OVERLOADED OPERATORS
+	BigInt operator + 	(const BigInt& lhs, const BigInt& rhs);
+	BigInt operator - 	(const BigInt& lhs, const BigInt& rhs);
+	BigInt operator * 	(const BigInt& lhs, const BigInt& rhs);
+	BigInt operator / 	(const BigInt& lhs, const BigInt& rhs);
+	BigInt operator % 	(const BigInt& lhs, const BigInt& rhs);
+	bool operator == 	(const BigInt& lhs, const BigInt& rhs);
+	bool operator != 	(const BigInt& lhs, const BigInt& rhs);
+	bool operator < 	(const BigInt& lhs, const BigInt& rhs);
+	bool operator > 	(const BigInt& lhs, const BigInt& rhs);
+	bool operator <= 	(const BigInt& lhs, const BigInt& rhs);
+	bool operator >= 	(const BigInt& lhs, const BigInt& rhs);
+
+	//	INPUT AND OUTPUT, in decimal
+	std::istream& operator >> (std::istream& stream, BigInt& rhs);
+	std::ostream& operator << (std::ostream& stream, const BigInt& rhs);
+}
@@ -2,6 +2,62 @@
 
 //  SYSTEM
 #include <algorithm>
+#include <utility>
+#include <memory_resource>
+
+//  SETTINGS
+#include "../Settings/Settings.hpp"
+
+//  Capacity grows at least this many times when a buffer runs out of space
+const int BUFFER_GROWTH_FACTOR = 2;
+
+//  A buffer takes memory from the resource it is made with and gives it back to the same
+//  resource. Matrices get theirs as a ctor argument; one made without an argument takes
+//  Memory::Current (). Assignment never moves a matrix to another resource, as with the
+//  std::pmr containers: the destination keeps its own, and the elements are copied into it
+//  when the two resources differ.
+namespace Memory {
+    //  The resource of matrices made without one: the innermost Scope on this thread, the
+    //  default resource outside scopes. A Scope only chooses where new matrices go, so a
+    //  matrix made outside it keeps its memory when it is assigned inside.
+    //  A Scope covers matrix buffers made on its own thread, nothing else:
+    //  - pool workers of a parallel operation do not see the caller's Scope, so a matrix
+    //    they make goes to the default resource;
+    //  - scratch that is not a matrix (the std::vector members of Solver, SparseLU and QR,
+    //    the GEMM packing workspace) always comes from the global heap.
+    std::pmr::memory_resource* Current ();
+
+    class Scope final {
+        private:
+            std::pmr::memory_resource* previous_ = nullptr;
+        public:
+            explicit Scope (std::pmr::memory_resource* resource);
+            ~Scope ();
+
+            Scope (const Scope& rhs) = delete;
+            Scope& operator = (const Scope& rhs) = delete;
+    };
+
+    inline std::pmr::memory_resource*& CurrentSlot () {
+        thread_local std::pmr::memory_resource* resource = nullptr;
+        return resource;
+    }
+}
+
+inline std::pmr::memory_resource* Memory::Current () {
+    std::pmr::memory_resource* resource = CurrentSlot ();
+    return (resource ? resource : std::pmr::get_default_resource ());
+}
+
+inline Memory::Scope::Scope (std::pmr::memory_resource* resource):
+    previous_ (CurrentSlot ())
+    {
+        CurrentSlot () = resource;
+    }
+
+inline Memory::Scope::~Scope () {
+    CurrentSlot () = previous_;
+}
 
 template <typename T>
 class MatrixBuffer {
@@ -11,22 +67,51 @@ class MatrixBuffer {
         //  DATA
         int size_ = 0, used_ = 0;
         T* data_ = nullptr;
+        std::pmr::memory_resource* resource_ = nullptr;
 
         //  CTOR
-        MatrixBuffer (int size = 0):
+        MatrixBuffer (int size = 0, std::pmr::memory_resource* resource = Memory::Current ()):
             size_ (size),
             used_ (0),
-            data_ (nullptr)
+            data_ (nullptr),
+            resource_ (resource)
             {
                 int memorySize = size * sizeof (T);
-                data_ = (size == 0 ? nullptr : static_cast <T*> (::operator new [] (memorySize)));
+                data_ = (size == 0 ? nullptr : static_cast <T*> (resource_->allocate (memorySize, Alignment ())));
             }
 
-        //  METHOD
+        //  Every buffer starts on MATRIX_ALIGNMENT bytes
+        static constexpr size_t Alignment () {
+            return std::max <size_t> (alignof (T), MATRIX_ALIGNMENT);
+        }
+
+        //  METHODS
         void Swap (MatrixBuffer& rhs) {
             std::swap (this->size_, rhs.size_);
             std::swap (this->used_, rhs.used_);
             std::swap (this->data_, rhs.data_);
+            std::swap (this->resource_, rhs.resource_);
+        }
+
+        //  Moves the constructed elements into a buffer for capacity elements
+        void Reserve (int capacity) {
+            if (capacity <= size_) {
+                return;
+            }
+            //  Growing stays in the resource the buffer came from
+            MatrixBuffer temp { capacity, resource_ };
+            for (int i = 0; i < used_; ++i) {
+                new (temp.data_ + i) T { std::move (data_[i]) };
+                ++temp.used_;
+            }
+            Swap (temp);
+        }
+
+        //  Reserve with geometric growth, so repeated appends are amortized O(1) per element
+        void Grow (int required) {
+            if (required > size_) {
+                Reserve (std::max (required, size_ * BUFFER_GROWTH_FACTOR));
+            }
         }
         
         //  DTOR
@@ -34,12 +119,17 @@ class MatrixBuffer {
             for (int i = 0; i < used_; ++i) {
                 data_[i].~T ();
             }
-            operator delete [] (data_);
+            if (data_) {
+                resource_->deallocate (data_, size_ * sizeof (T), Alignment ());
+            }
         }
     public:
         //  CTOR
         MatrixBuffer (const MatrixBuffer& rhs) = delete;
 
+        //  GETTER
+        std::pmr::memory_resource* Resource () const { return resource_; }
+
         //  OVERLOADED OPERATOR
         MatrixBuffer& operator = (const MatrixBuffer& rhs) = delete;
 };
\ No newline at end of file
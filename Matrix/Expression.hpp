@@ -0,0 +1,191 @@
+#pragma once
+
+//	SYSTEM
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+
+namespace Linear {
+	using PairInt = std::pair <int, int>;
+
+	template <typename T>
+	class Matrix;
+	template <typename T>
+	class MatrixView;
+
+	//	Lazy elementwise arithmetic: a + b - 2.0 * c is a tree of small nodes holding
+	//	references to the matrices, evaluated in one pass when assigned to a Matrix.
+	//	Matrix products are not elementwise, so they are computed (GEMM) right away.
+	//	Nodes refer to their operands: keep them inside one full expression, not in auto.
+	namespace Expression {
+		//	BASE OF EVERY NODE
+		template <typename E>
+		struct Node {
+			const E& Self () const { return static_cast <const E&> (*this); }
+		};
+
+		//	MATRIX AS A NODE
+		template <typename T>
+		class Leaf final : public Node <Leaf <T>> {
+			private:
+				const Matrix <T>& matrix_;
+			public:
+				using Value = T;
+				explicit Leaf (const Matrix <T>& matrix): matrix_ (matrix) {}
+				PairInt Shape () const { return matrix_.Shape (); }
+				T operator () (int i, int j) const { return matrix_ (i, j); }
+		};
+
+		//	ELEMENTWISE OPERATIONS
+		struct Plus {
+			template <typename T>
+			static T Apply (const T& lhs, const T& rhs) { return lhs + rhs; }
+		};
+		struct Minus {
+			template <typename T>
+			static T Apply (const T& lhs, const T& rhs) { return lhs - rhs; }
+		};
+
+		template <typename L, typename R, typename Op>
+		class Binary final : public Node <Binary <L, R, Op>> {
+			private:
+				L lhs_;
+				R rhs_;
+			public:
+				using Value = typename L::Value;
+				static_assert (std::is_same <typename L::Value, typename R::Value>::value, "Matrix element types differ.");
+
+				Binary (const L& lhs, const R& rhs):
+					lhs_ (lhs),
+					rhs_ (rhs)
+					{
+						if (lhs_.Shape () != rhs_.Shape ()) {
+							throw (std::invalid_argument ("Matrix sizes do not match."));
+						}
+					}
+				PairInt Shape () const { return lhs_.Shape (); }
+				Value operator () (int i, int j) const { return Op::Apply (lhs_ (i, j), rhs_ (i, j)); }
+		};
+
+		template <typename E>
+		class Scaled final : public Node <Scaled <E>> {
+			private:
+				E expression_;
+				typename E::Value number_;
+			public:
+				using Value = typename E::Value;
+				Scaled (const E& expression, const Value& number):
+					expression_ (expression),
+					number_ (number)
+					{}
+				PairInt Shape () const { return expression_.Shape (); }
+				Value operator () (int i, int j) const { return expression_ (i, j) * number_; }
+		};
+
+		template <typename E>
+		class Negated final : public Node <Negated <E>> {
+			private:
+				E expression_;
+			public:
+				using Value = typename E::Value;
+				explicit Negated (const E& expression): expression_ (expression) {}
+				PairInt Shape () const { return expression_.Shape (); }
+				Value operator () (int i, int j) const { return -expression_ (i, j); }
+		};
+
+		//	OPERANDS: a Matrix becomes a Leaf, a node stays itself
+		template <typename T>
+		Leaf <T> Wrap (const Matrix <T>& matrix) { return Leaf <T> { matrix }; }
+		template <typename E>
+		const E& Wrap (const Node <E>& node) { return node.Self (); }
+
+		template <typename X>
+		using NodeOf = std::decay_t <decltype (Wrap (std::declval <const X&> ()))>;
+		template <typename X>
+		using ValueOf = typename NodeOf <X>::Value;
+
+		//	Products need their operands in memory, matrices and views already are
+		template <typename T>
+		const Matrix <T>& Evaluate (const Matrix <T>& matrix) { return matrix; }
+		template <typename T>
+		const MatrixView <T>& Evaluate (const MatrixView <T>& view) { return view; }
+		template <typename E>
+		Matrix <typename E::Value> Evaluate (const Node <E>& node) { return Matrix <typename E::Value> { node }; }
+
+		//	Strides of an evaluated operand for GEMM
+		template <typename T>
+		MatrixView <const T> Strided (const Matrix <T>& matrix) { return matrix.View (); }
+		template <typename T>
+		MatrixView <const std::remove_const_t <T>> Strided (const MatrixView <T>& view) { return view; }
+
+		template <typename L, typename R>
+		using ProductOf = std::enable_if_t <std::is_same <ValueOf <L>, ValueOf <R>>::value, Matrix <ValueOf <L>>>;
+	}
+
+	//	OVERLOADED OPERATORS
+	template <typename L, typename R>
+	Expression::Binary <Expression::NodeOf <L>, Expression::NodeOf <R>, Expression::Plus> operator + (const L& lhs, const R& rhs);
+	template <typename L, typename R>
+	Expression::Binary <Expression::NodeOf <L>, Expression::NodeOf <R>, Expression::Minus> operator - (const L& lhs, const R& rhs);
+	template <typename E>
+	Expression::Negated <Expression::NodeOf <E>> operator - (const E& rhs);
+	template <typename E>
+	Expression::Scaled <Expression::NodeOf <E>> operator * (const Expression::ValueOf <E>& number, const E& rhs);
+	template <typename E>
+	Expression::Scaled <Expression::NodeOf <E>> operator * (const E& lhs, const Expression::ValueOf <E>& number);
+	template <typename L, typename R>
+	Expression::ProductOf <L, R> operator * (const L& lhs, const R& rhs);
+
+	//	Argument-dependent lookup for nodes searches Expression, not Linear
+	namespace Expression {
+		using Linear::operator +;
+		using Linear::operator -;
+		using Linear::operator *;
+	}
+}
+
+template <typename L, typename R>
+Linear::Expression::Binary <Linear::Expression::NodeOf <L>, Linear::Expression::NodeOf <R>, Linear::Expression::Plus>
+Linear::operator + (const L& lhs, const R& rhs) {
+	return { Expression::Wrap (lhs), Expression::Wrap (rhs) };
+}
+
+template <typename L, typename R>
+Linear::Expression::Binary <Linear::Expression::NodeOf <L>, Linear::Expression::NodeOf <R>, Linear::Expression::Minus>
+Linear::operator - (const L& lhs, const R& rhs) {
+	return { Expression::Wrap (lhs), Expression::Wrap (rhs) };
+}
+
+template <typename E>
+Linear::Expression::Negated <Linear::Expression::NodeOf <E>> Linear::operator - (const E& rhs) {
+	return Expression::Negated <Expression::NodeOf <E>> { Expression::Wrap (rhs) };
+}
+
+template <typename E>
+Linear::Expression::Scaled <Linear::Expression::NodeOf <E>> Linear::operator * (const Expression::ValueOf <E>& number, const E& rhs) {
+	return { Expression::Wrap (rhs), number };
+}
+
+template <typename E>
+Linear::Expression::Scaled <Linear::Expression::NodeOf <E>> Linear::operator * (const E& lhs, const Expression::ValueOf <E>& number) {
+	return { Expression::Wrap (lhs), number };
+}
+
+template <typename L, typename R>
+Linear::Expression::ProductOf <L, R> Linear::operator * (const L& lhs, const R& rhs) {
+	//	Transposed and block views go to GEMM with their strides, without copies
+	const auto& left = Expression::Evaluate (lhs);
+	const auto& right = Expression::Evaluate (rhs);
+	auto a = Expression::Strided (left);
+	auto b = Expression::Strided (right);
+	if (a.Shape ().second != b.Shape ().first) {
+		throw (std::invalid_argument ("Trying to multiply by a matrix with inappropriate size."));
+	}
+	int m = a.Shape ().first, n = b.Shape ().second, k = a.Shape ().second;
+	Matrix <Expression::ValueOf <L>> ans { m, n };
+	if (m > 0 && n > 0 && k > 0) {
+		Gemm::Multiply (m, n, k, a.Data (), a.RowStride (), a.ColStride (), b.Data (), b.RowStride (), b.ColStride (),
+						ans.Row (0), ans.LeadingDimension ());
+	}
+	return ans;
+}
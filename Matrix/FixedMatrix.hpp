@@ -0,0 +1,299 @@
+#pragma once
+
+//	SYSTEM
+#include <array>
+#include <utility>
+#include <stdexcept>
+
+//	MATRIX
+#include "Matrix.hpp"
+
+namespace Linear {
+	//	R x C matrix with inline storage: no allocation, and the sizes are known to the
+	//	compiler, so the loops over them are unrolled. Meant for 2 x 2 ... 4 x 4 blocks.
+	//	It is an expression node as well: a Matrix can be built from it and it mixes with
+	//	matrices in elementwise expressions, while fixed op fixed stays a FixedMatrix.
+	template <typename T, int R, int C>
+	class FixedMatrix final : public Expression::Node <FixedMatrix <T, R, C>> {
+		static_assert (R > 0 && C > 0, "Fixed matrix sizes must be positive.");
+		private:
+			//	DATA
+			std::array <T, R * C> data_ {};
+		public:
+			using Value = T;
+
+			//	CTORS
+			constexpr 			FixedMatrix () = default;
+			constexpr explicit 	FixedMatrix (const std::array <T, R * C>& data);
+			explicit 			FixedMatrix (const Matrix <T>& matrix);
+
+			//	BASIC TYPES
+			static constexpr FixedMatrix Eye ();
+
+			//	GETTERS
+			static constexpr PairInt 	Shape 		();
+			constexpr T 				Trace 		() const;
+			const T& 					At 			(int i, int j) const;
+
+			//	UNCHECKED GETTER FOR INTERNAL ALGORITHMS
+			constexpr const T& 			operator () (int i, int j) const;
+
+			//	SETTERS
+			T& 					At 			(int i, int j);
+			constexpr T& 		operator () (int i, int j);
+
+			//	OVERLOADED OPERATORS
+			constexpr bool operator == (const FixedMatrix& rhs) const;
+			constexpr bool operator != (const FixedMatrix& rhs) const;
+
+			//	ALGEBRA
+			constexpr FixedMatrix <T, C, R> 		Transposed 	() const;
+			//	Without row and col, square matrices larger than 1 x 1 only
+			constexpr FixedMatrix <T, R - 1, C - 1> Minor 		(int row, int col) const;
+			constexpr T 							Determinant () const;
+			constexpr FixedMatrix 					Inverse 	() const;
+	};
+
+	//	OVERLOADED OPERATORS
+	template <typename T, int R, int C>
+	constexpr FixedMatrix <T, R, C> operator + (const FixedMatrix <T, R, C>& lhs, const FixedMatrix <T, R, C>& rhs);
+	template <typename T, int R, int C>
+	constexpr FixedMatrix <T, R, C> operator - (const FixedMatrix <T, R, C>& lhs, const FixedMatrix <T, R, C>& rhs);
+	template <typename T, int R, int C>
+	constexpr FixedMatrix <T, R, C> operator - (const FixedMatrix <T, R, C>& rhs);
+	template <typename T, int R, int C>
+	constexpr FixedMatrix <T, R, C> operator * (const typename FixedMatrix <T, R, C>::Value& number, const FixedMatrix <T, R, C>& rhs);
+	template <typename T, int R, int C>
+	constexpr FixedMatrix <T, R, C> operator * (const FixedMatrix <T, R, C>& lhs, const typename FixedMatrix <T, R, C>::Value& number);
+	template <typename T, int R, int K, int C>
+	constexpr FixedMatrix <T, R, C> operator * (const FixedMatrix <T, R, K>& lhs, const FixedMatrix <T, K, C>& rhs);
+
+	//	OUTPUT
+	template <typename T, int R, int C>
+	std::ostream& operator << (std::ostream& stream, const FixedMatrix <T, R, C>& rhs);
+
+	namespace Fixed {
+		//	Row i of lhs times column j of rhs, one term per k, written out at compile time
+		template <typename T, int R, int K, int C, std::size_t... k>
+		constexpr T Dot (const FixedMatrix <T, R, K>& lhs, const FixedMatrix <T, K, C>& rhs, int i, int j, std::index_sequence <k...>) {
+			return (T {} + ... + (lhs (i, k) * rhs (k, j)));
+		}
+	}
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C>::FixedMatrix (const std::array <T, R * C>& data):
+	data_ (data)
+	{}
+
+template <typename T, int R, int C>
+Linear::FixedMatrix <T, R, C>::FixedMatrix (const Matrix <T>& matrix) {
+	if (matrix.Shape () != Shape ()) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			(*this) (i, j) = matrix (i, j);
+		}
+	}
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::FixedMatrix <T, R, C>::Eye () {
+	FixedMatrix ans {};
+	for (int i = 0; i < std::min (R, C); ++i) {
+		ans (i, i) = static_cast <T> (1);
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::PairInt Linear::FixedMatrix <T, R, C>::Shape () {
+	return PairInt { R, C };
+}
+
+template <typename T, int R, int C>
+constexpr T Linear::FixedMatrix <T, R, C>::Trace () const {
+	T ans {};
+	for (int i = 0; i < std::min (R, C); ++i) {
+		ans += (*this) (i, i);
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+const T& Linear::FixedMatrix <T, R, C>::At (int i, int j) const {
+	if (i < 0 || i >= R || j < 0 || j >= C) {
+		std::stringstream message {};
+		message << "Wrong i / j value: i = " << i << ", j = " << j << ".";
+		throw (std::invalid_argument (message.str ()));
+	}
+	return (*this) (i, j);
+}
+
+template <typename T, int R, int C>
+constexpr const T& Linear::FixedMatrix <T, R, C>::operator () (int i, int j) const {
+	return data_[i * C + j];
+}
+
+template <typename T, int R, int C>
+T& Linear::FixedMatrix <T, R, C>::At (int i, int j) {
+	return const_cast <T&> (static_cast <const FixedMatrix&> (*this).At (i, j));
+}
+
+template <typename T, int R, int C>
+constexpr T& Linear::FixedMatrix <T, R, C>::operator () (int i, int j) {
+	return data_[i * C + j];
+}
+
+template <typename T, int R, int C>
+constexpr bool Linear::FixedMatrix <T, R, C>::operator == (const FixedMatrix& rhs) const {
+	for (int i = 0; i < R * C; ++i) {
+		if (data_[i] != rhs.data_[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T, int R, int C>
+constexpr bool Linear::FixedMatrix <T, R, C>::operator != (const FixedMatrix& rhs) const {
+	return !(*this == rhs);
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, C, R> Linear::FixedMatrix <T, R, C>::Transposed () const {
+	FixedMatrix <T, C, R> ans {};
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			ans (j, i) = (*this) (i, j);
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R - 1, C - 1> Linear::FixedMatrix <T, R, C>::Minor (int row, int col) const {
+	FixedMatrix <T, R - 1, C - 1> ans {};
+	for (int i = 0; i < R - 1; ++i) {
+		for (int j = 0; j < C - 1; ++j) {
+			ans (i, j) = (*this) (i < row ? i : i + 1, j < col ? j : j + 1);
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr T Linear::FixedMatrix <T, R, C>::Determinant () const {
+	static_assert (R == C, "Trying to calcute non-square matrix determinant.");
+	const FixedMatrix& m = *this;
+	if constexpr (R == 1) {
+		return m (0, 0);
+	}
+	else if constexpr (R == 2) {
+		return m (0, 0) * m (1, 1) - m (0, 1) * m (1, 0);
+	}
+	else if constexpr (R == 3) {
+		return m (0, 0) * (m (1, 1) * m (2, 2) - m (1, 2) * m (2, 1))
+			 - m (0, 1) * (m (1, 0) * m (2, 2) - m (1, 2) * m (2, 0))
+			 + m (0, 2) * (m (1, 0) * m (2, 1) - m (1, 1) * m (2, 0));
+	}
+	else {
+		//	Laplace expansion down to the 3 x 3 formula
+		T ans {};
+		for (int j = 0; j < C; ++j) {
+			T term = m (0, j) * Minor (0, j).Determinant ();
+			ans += (j % 2 == 0 ? term : -term);
+		}
+		return ans;
+	}
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::FixedMatrix <T, R, C>::Inverse () const {
+	//	Adjugate over the determinant
+	static_assert (R == C, "Matrix is not square.");
+	T determinant = Determinant ();
+	if (determinant == T {}) {
+		throw (std::runtime_error ("Matrix is singular."));
+	}
+	FixedMatrix ans {};
+	if constexpr (R == 1) {
+		ans (0, 0) = static_cast <T> (1) / determinant;
+	}
+	else {
+		for (int i = 0; i < R; ++i) {
+			for (int j = 0; j < C; ++j) {
+				T cofactor = Minor (i, j).Determinant () / determinant;
+				ans (j, i) = ((i + j) % 2 == 0 ? cofactor : -cofactor);
+			}
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::operator + (const FixedMatrix <T, R, C>& lhs, const FixedMatrix <T, R, C>& rhs) {
+	FixedMatrix <T, R, C> ans { lhs };
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			ans (i, j) += rhs (i, j);
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::operator - (const FixedMatrix <T, R, C>& lhs, const FixedMatrix <T, R, C>& rhs) {
+	FixedMatrix <T, R, C> ans { lhs };
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			ans (i, j) -= rhs (i, j);
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::operator - (const FixedMatrix <T, R, C>& rhs) {
+	FixedMatrix <T, R, C> ans {};
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			ans (i, j) = -rhs (i, j);
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::operator * (const typename FixedMatrix <T, R, C>::Value& number, const FixedMatrix <T, R, C>& rhs) {
+	FixedMatrix <T, R, C> ans { rhs };
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			ans (i, j) *= number;
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::operator * (const FixedMatrix <T, R, C>& lhs, const typename FixedMatrix <T, R, C>::Value& number) {
+	return number * lhs;
+}
+
+template <typename T, int R, int K, int C>
+constexpr Linear::FixedMatrix <T, R, C> Linear::operator * (const FixedMatrix <T, R, K>& lhs, const FixedMatrix <T, K, C>& rhs) {
+	FixedMatrix <T, R, C> ans {};
+	for (int i = 0; i < R; ++i) {
+		for (int j = 0; j < C; ++j) {
+			ans (i, j) = Fixed::Dot (lhs, rhs, i, j, std::make_index_sequence <K> {});
+		}
+	}
+	return ans;
+}
+
+template <typename T, int R, int C>
+std::ostream& Linear::operator << (std::ostream& stream, const FixedMatrix <T, R, C>& rhs) {
+	Matrix <T> { rhs }.Dump (stream);
+	return stream;
+}
@@ -0,0 +1,95 @@
+#include "Gemm.hpp"
+
+//	SYSTEM
+#include <immintrin.h>
+
+namespace {
+	//	6 x 8 doubles: 12 accumulators + 2 B vectors + 1 broadcast fit in 16 ymm registers
+	__attribute__ ((target ("avx2,fma")))
+	void KernelDoubleAvx2 (int kc, const double* a, const double* b, double* c, int ldc) {
+		__m256d c00 = _mm256_setzero_pd (), c01 = _mm256_setzero_pd ();
+		__m256d c10 = _mm256_setzero_pd (), c11 = _mm256_setzero_pd ();
+		__m256d c20 = _mm256_setzero_pd (), c21 = _mm256_setzero_pd ();
+		__m256d c30 = _mm256_setzero_pd (), c31 = _mm256_setzero_pd ();
+		__m256d c40 = _mm256_setzero_pd (), c41 = _mm256_setzero_pd ();
+		__m256d c50 = _mm256_setzero_pd (), c51 = _mm256_setzero_pd ();
+		for (int p = 0; p < kc; ++p) {
+			__m256d b0 = _mm256_loadu_pd (b), b1 = _mm256_loadu_pd (b + 4);
+			__m256d ai = _mm256_broadcast_sd (a + 0);
+			c00 = _mm256_fmadd_pd (ai, b0, c00); c01 = _mm256_fmadd_pd (ai, b1, c01);
+			ai = _mm256_broadcast_sd (a + 1);
+			c10 = _mm256_fmadd_pd (ai, b0, c10); c11 = _mm256_fmadd_pd (ai, b1, c11);
+			ai = _mm256_broadcast_sd (a + 2);
+			c20 = _mm256_fmadd_pd (ai, b0, c20); c21 = _mm256_fmadd_pd (ai, b1, c21);
+			ai = _mm256_broadcast_sd (a + 3);
+			c30 = _mm256_fmadd_pd (ai, b0, c30); c31 = _mm256_fmadd_pd (ai, b1, c31);
+			ai = _mm256_broadcast_sd (a + 4);
+			c40 = _mm256_fmadd_pd (ai, b0, c40); c41 = _mm256_fmadd_pd (ai, b1, c41);
+			ai = _mm256_broadcast_sd (a + 5);
+			c50 = _mm256_fmadd_pd (ai, b0, c50); c51 = _mm256_fmadd_pd (ai, b1, c51);
+			a += 6;
+			b += 8;
+		}
+		__m256d acc [6][2] = { { c00, c01 }, { c10, c11 }, { c20, c21 }, { c30, c31 }, { c40, c41 }, { c50, c51 } };
+		for (int i = 0; i < 6; ++i) {
+			double* row = c + i * ldc;
+			_mm256_storeu_pd (row, _mm256_add_pd (_mm256_loadu_pd (row), acc[i][0]));
+			_mm256_storeu_pd (row + 4, _mm256_add_pd (_mm256_loadu_pd (row + 4), acc[i][1]));
+		}
+	}
+
+	//	6 x 16 floats, same register budget as the double kernel
+	__attribute__ ((target ("avx2,fma")))
+	void KernelFloatAvx2 (int kc, const float* a, const float* b, float* c, int ldc) {
+		__m256 c00 = _mm256_setzero_ps (), c01 = _mm256_setzero_ps ();
+		__m256 c10 = _mm256_setzero_ps (), c11 = _mm256_setzero_ps ();
+		__m256 c20 = _mm256_setzero_ps (), c21 = _mm256_setzero_ps ();
+		__m256 c30 = _mm256_setzero_ps (), c31 = _mm256_setzero_ps ();
+		__m256 c40 = _mm256_setzero_ps (), c41 = _mm256_setzero_ps ();
+		__m256 c50 = _mm256_setzero_ps (), c51 = _mm256_setzero_ps ();
+		for (int p = 0; p < kc; ++p) {
+			__m256 b0 = _mm256_loadu_ps (b), b1 = _mm256_loadu_ps (b + 8);
+			__m256 ai = _mm256_broadcast_ss (a + 0);
+			c00 = _mm256_fmadd_ps (ai, b0, c00); c01 = _mm256_fmadd_ps (ai, b1, c01);
+			ai = _mm256_broadcast_ss (a + 1);
+			c10 = _mm256_fmadd_ps (ai, b0, c10); c11 = _mm256_fmadd_ps (ai, b1, c11);
+			ai = _mm256_broadcast_ss (a + 2);
+			c20 = _mm256_fmadd_ps (ai, b0, c20); c21 = _mm256_fmadd_ps (ai, b1, c21);
+			ai = _mm256_broadcast_ss (a + 3);
+			c30 = _mm256_fmadd_ps (ai, b0, c30); c31 = _mm256_fmadd_ps (ai, b1, c31);
+			ai = _mm256_broadcast_ss (a + 4);
+			c40 = _mm256_fmadd_ps (ai, b0, c40); c41 = _mm256_fmadd_ps (ai, b1, c41);
+			ai = _mm256_broadcast_ss (a + 5);
+			c50 = _mm256_fmadd_ps (ai, b0, c50); c51 = _mm256_fmadd_ps (ai, b1, c51);
+			a += 6;
+			b += 16;
+		}
+		__m256 acc [6][2] = { { c00, c01 }, { c10, c11 }, { c20, c21 }, { c30, c31 }, { c40, c41 }, { c50, c51 } };
+		for (int i = 0; i < 6; ++i) {
+			float* row = c + i * ldc;
+			_mm256_storeu_ps (row, _mm256_add_ps (_mm256_loadu_ps (row), acc[i][0]));
+			_mm256_storeu_ps (row + 8, _mm256_add_ps (_mm256_loadu_ps (row + 8), acc[i][1]));
+		}
+	}
+
+	bool HasAvx2 () {
+		__builtin_cpu_init ();
+		return __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+	}
+}
+
+template <>
+Linear::Gemm::MicroKernel <double> Linear::Gemm::SelectKernel <double> () {
+	if (HasAvx2 ()) {
+		return { 6, 8, &KernelDoubleAvx2 };
+	}
+	return { 4, 4, &GenericKernel <double, 4, 4> };
+}
+
+template <>
+Linear::Gemm::MicroKernel <float> Linear::Gemm::SelectKernel <float> () {
+	if (HasAvx2 ()) {
+		return { 6, 16, &KernelFloatAvx2 };
+	}
+	return { 4, 4, &GenericKernel <float, 4, 4> };
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+//	SYSTEM
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+//	THREADS
+#include "../Parallel/ThreadPool.hpp"
+
+namespace Linear {
+	namespace Gemm {
+		//	BLOCKING PARAMETERS
+		//	MC x KC block of A stays in L2, KC x NC panel of B stays in L3,
+		//	MR x NR block of C stays in registers inside the micro-kernel
+		const int MC = 96;
+		const int KC = 256;
+		const int NC = 2048;
+
+		//	Below this number of multiply-adds packing costs more than it saves
+		const long long SMALL_SIZE = 32 * 32 * 32;
+
+		//	MICRO-KERNEL
+		//	Computes C (MR x NR) += A_packed (MR x kc) * B_packed (kc x NR)
+		template <typename T>
+		struct MicroKernel {
+			int mr = 0, nr = 0;
+			void (*run) (int kc, const T* a, const T* b, T* c, int ldc) = nullptr;
+		};
+
+		template <typename T, int MR, int NR>
+		void GenericKernel (int kc, const T* a, const T* b, T* c, int ldc);
+
+		template <typename T>
+		MicroKernel <T> SelectKernel ();
+		//	Vectorized kernels, chosen at runtime by CPU features (Gemm.cpp)
+		template <>
+		MicroKernel <double> SelectKernel <double> ();
+		template <>
+		MicroKernel <float> SelectKernel <float> ();
+
+		//	PACKING
+		//	Buffers of the calling thread, kept between products. A product makes them only
+		//	as large as its own blocks need, so after the first product of a given size
+		//	packing neither allocates nor zero-fills
+		template <typename T>
+		struct Workspace {
+			std::vector <T> packedA {}, packedB {}, edge {};
+
+			static Workspace& Local () {
+				thread_local Workspace workspace {};
+				return workspace;
+			}
+			static T* Reserve (std::vector <T>& buffer, size_t size) {
+				if (buffer.size () < size) {
+					buffer.resize (size);
+				}
+				return buffer.data ();
+			}
+		};
+
+		//	Element (i, j) of A is a[i * rsa + j * csa], the same for B
+		template <typename T>
+		void PackA (int mc, int kc, const T* a, int rsa, int csa, int mr, bool negate, T* packed);
+		template <typename T>
+		void PackB (int kc, int nc, const T* b, int rsb, int csb, int nr, T* packed);
+
+		//	REALIZATION
+		//	C (m x n) += A (m x k) * B (k x n), or C -= A * B if subtract is set.
+		//	A and B may have any strides (transposed or strided views), rows of C are contiguous.
+		template <typename T>
+		void Simple (int m, int n, int k, const T* a, int rsa, int csa, const T* b, int rsb, int csb, T* c, int ldc, bool subtract = false);
+		template <typename T>
+		void Blocked (int m, int n, int k, const T* a, int rsa, int csa, const T* b, int rsb, int csb, T* c, int ldc, bool subtract = false);
+		//	Under PARALLEL, bands of at least MC rows of C go to different threads
+		template <typename T>
+		void Multiply (int m, int n, int k, const T* a, int rsa, int csa, const T* b, int rsb, int csb, T* c, int ldc, bool subtract = false,
+					   Parallel::Policy policy = Parallel::Current ());
+		//	Row-major A, B and C, lda / ldb / ldc are row lengths in memory
+		template <typename T>
+		void Multiply (int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc, bool subtract = false,
+					   Parallel::Policy policy = Parallel::Current ());
+	}
+}
+
+template <typename T, int MR, int NR>
+void Linear::Gemm::GenericKernel (int kc, const T* a, const T* b, T* c, int ldc) {
+	T acc [MR][NR] {};
+	for (int p = 0; p < kc; ++p) {
+		for (int i = 0; i < MR; ++i) {
+			for (int j = 0; j < NR; ++j) {
+				acc[i][j] += a[i] * b[j];
+			}
+		}
+		a += MR;
+		b += NR;
+	}
+	for (int i = 0; i < MR; ++i) {
+		for (int j = 0; j < NR; ++j) {
+			c[i * ldc + j] += acc[i][j];
+		}
+	}
+}
+
+template <typename T>
+Linear::Gemm::MicroKernel <T> Linear::Gemm::SelectKernel () {
+	return { 4, 4, &GenericKernel <T, 4, 4> };
+}
+
+template <typename T>
+void Linear::Gemm::PackA (int mc, int kc, const T* a, int rsa, int csa, int mr, bool negate, T* packed) {
+	//	Panels of mr rows, stored column by column; the last panel is zero-padded
+	for (int i = 0; i < mc; i += mr) {
+		int rows = std::min (mr, mc - i);
+		for (int p = 0; p < kc; ++p) {
+			for (int r = 0; r < rows; ++r) {
+				const T& value = a[(i + r) * rsa + p * csa];
+				*packed++ = (negate ? -value : value);
+			}
+			for (int r = rows; r < mr; ++r) {
+				*packed++ = T {};
+			}
+		}
+	}
+}
+
+template <typename T>
+void Linear::Gemm::PackB (int kc, int nc, const T* b, int rsb, int csb, int nr, T* packed) {
+	//	Panels of nr columns, stored row by row; the last panel is zero-padded
+	for (int j = 0; j < nc; j += nr) {
+		int cols = std::min (nr, nc - j);
+		for (int p = 0; p < kc; ++p) {
+			const T* row = b + p * rsb + j * csb;
+			for (int c = 0; c < cols; ++c) {
+				*packed++ = row[c * csb];
+			}
+			for (int c = cols; c < nr; ++c) {
+				*packed++ = T {};
+			}
+		}
+	}
+}
+
+template <typename T>
+void Linear::Gemm::Simple (int m, int n, int k, const T* a, int rsa, int csa, const T* b, int rsb, int csb, T* c, int ldc, bool subtract) {
+	//	i-k-j order: both B and C are walked along rows
+	for (int i = 0; i < m; ++i) {
+		T* cRow = c + i * ldc;
+		for (int p = 0; p < k; ++p) {
+			const T& factor = a[i * rsa + p * csa];
+			const T* bRow = b + p * rsb;
+			if (csb == 1) {
+				for (int j = 0; j < n; ++j) {
+					if (subtract) {
+						cRow[j] -= factor * bRow[j];
+					}
+					else {
+						cRow[j] += factor * bRow[j];
+					}
+				}
+			}
+			else {
+				for (int j = 0; j < n; ++j) {
+					if (subtract) {
+						cRow[j] -= factor * bRow[j * csb];
+					}
+					else {
+						cRow[j] += factor * bRow[j * csb];
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+void Linear::Gemm::Blocked (int m, int n, int k, const T* a, int rsa, int csa, const T* b, int rsb, int csb, T* c, int ldc, bool subtract) {
+	static const MicroKernel <T> kernel = SelectKernel <T> ();
+	const int mr = kernel.mr, nr = kernel.nr;
+
+	//	Blocks are at most MC x KC of A and KC x NC of B, rounded up to whole panels
+	int mcMax = std::min (MC, m), kcMax = std::min (KC, k), ncMax = std::min (NC, n);
+	Workspace <T>& workspace = Workspace <T>::Local ();
+	T* packedA = Workspace <T>::Reserve (workspace.packedA, static_cast <size_t> ((mcMax + mr - 1) / mr) * mr * kcMax);
+	T* packedB = Workspace <T>::Reserve (workspace.packedB, static_cast <size_t> ((ncMax + nr - 1) / nr) * nr * kcMax);
+	T* edge = Workspace <T>::Reserve (workspace.edge, mr * nr);
+
+	for (int jc = 0; jc < n; jc += NC) {
+		int nc = std::min (NC, n - jc);
+		for (int pc = 0; pc < k; pc += KC) {
+			int kc = std::min (KC, k - pc);
+			PackB (kc, nc, b + pc * rsb + jc * csb, rsb, csb, nr, packedB);
+			for (int ic = 0; ic < m; ic += MC) {
+				int mc = std::min (MC, m - ic);
+				PackA (mc, kc, a + ic * rsa + pc * csa, rsa, csa, mr, subtract, packedA);
+				for (int jr = 0; jr < nc; jr += nr) {
+					int cols = std::min (nr, nc - jr);
+					for (int ir = 0; ir < mc; ir += mr) {
+						int rows = std::min (mr, mc - ir);
+						const T* aPanel = packedA + ir * kc;
+						const T* bPanel = packedB + jr * kc;
+						T* cBlock = c + (ic + ir) * ldc + jc + jr;
+						if (rows == mr && cols == nr) {
+							kernel.run (kc, aPanel, bPanel, cBlock, ldc);
+						}
+						else {
+							//	Partial tile: compute the full tile aside, then add what fits
+							std::fill (edge, edge + mr * nr, T {});
+							kernel.run (kc, aPanel, bPanel, edge, nr);
+							for (int i = 0; i < rows; ++i) {
+								for (int j = 0; j < cols; ++j) {
+									cBlock[i * ldc + j] += edge[i * nr + j];
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename T>
+void Linear::Gemm::Multiply (int m, int n, int k, const T* a, int rsa, int csa, const T* b, int rsb, int csb, T* c, int ldc, bool subtract,
+							 Parallel::Policy policy) {
+	if (m <= 0 || n <= 0 || k <= 0) {
+		return;
+	}
+	long long work = static_cast <long long> (m) * n * k;
+	//	The path is chosen for the whole product, so every element of C is summed
+	//	in the same order whichever band it falls into
+	bool blocked = (work > SMALL_SIZE);
+	Parallel::For (policy, 0, m, MC, work, [&] (int begin, int end) {
+		//	Packing relies on T {} being the additive identity and on unary minus,
+		//	so only arithmetic types take the blocked path
+		if constexpr (std::is_arithmetic <T>::value) {
+			if (blocked) {
+				Blocked (end - begin, n, k, a + begin * rsa, rsa, csa, b, rsb, csb, c + begin * ldc, ldc, subtract);
+				return;
+			}
+		}
+		Simple (end - begin, n, k, a + begin * rsa, rsa, csa, b, rsb, csb, c + begin * ldc, ldc, subtract);
+	});
+}
+
+template <typename T>
+void Linear::Gemm::Multiply (int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc, bool subtract,
+							 Parallel::Policy policy) {
+	Multiply (m, n, k, a, lda, 1, b, ldb, 1, c, ldc, subtract, policy);
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+//	SYSTEM
+#include <vector>
+#include <numeric>
+
+//	MATRIX
+#include "Matrix.hpp"
+
+//	THREADS
+#include "../Parallel/ThreadPool.hpp"
+
+namespace Linear {
+	//	Panel width of the blocked factorization
+	const int LU_BLOCK_SIZE = 64;
+	//	Trailing updates with fewer multiply-adds than this stay on the calling thread
+	const long long LU_PARALLEL_SIZE = 1 << 22;
+	//	Fewest trailing rows given to one thread
+	const int LU_PARALLEL_ROWS = 32;
+
+	//	P * A = L * U with partial pivoting, computed once and reused.
+	//	A column without a pivot (every candidate below EPS) is skipped instead of
+	//	stopping the factorization, so U is a row echelon form of A and rectangular
+	//	or singular matrices still get a correct rank.
+	//	Right-looking and blocked: a panel of LU_BLOCK_SIZE columns is factored with
+	//	row operations, then the trailing matrix gets one GEMM update split across
+	//	the shared thread pool.
+	template <typename T>
+	class LU final {
+		private:
+			//	DATA
+			//	L below the pivots (unit diagonal is implied), U on and to the right of them
+			Matrix <T> factors_ {};
+			//	Row i of P * A is row permutation_[i] of A
+			std::vector <int> permutation_ {};
+			//	Column of the pivot in each of the first rank_ rows
+			std::vector <int> pivotCols_ {};
+			int sign_ = 1;
+			int rank_ = 0;
+
+			//	AUXILIARY METHODS
+			void Factorize ();
+			int  FactorizePanel 	(int firstRow, int firstCol, int lastCol);
+			void UpdateTrailing 	(int firstRow, int lastRow, int firstPivot, int firstCol);
+			void CheckInvertible () const;
+		public:
+			//	CTORS
+			LU () = default;
+			explicit LU (Matrix <T> matrix);
+
+			//	GETTERS
+			PairInt 					Shape 		() const;
+			int 						Rank 		() const;
+			int 						Sign 		() const;
+			bool 						IsSingular 	() const;
+			const std::vector <int>& 	Permutation () const;
+			const std::vector <int>& 	PivotCols 	() const;
+			const Matrix <T>& 			Factors 	() const;
+			Matrix <T> 					L 			() const;
+			Matrix <T> 					U 			() const;
+
+			//	ALGEBRA
+			T 			Determinant () const;
+			Matrix <T> 	Solve 		(const Matrix <T>& rhs) const;
+			Matrix <T> 	Inverse 	() const;
+	};
+}
+
+template <typename T>
+Linear::LU <T>::LU (Matrix <T> matrix):
+	factors_ (std::move (matrix)),
+	permutation_ (factors_.Shape ().first),
+	pivotCols_ ({}),
+	sign_ (1),
+	rank_ (0)
+	{
+		std::iota (permutation_.begin (), permutation_.end (), 0);
+		Factorize ();
+	}
+
+template <typename T>
+void Linear::LU <T>::Factorize () {
+	int nRows = factors_.Shape ().first, nCols = factors_.Shape ().second;
+	int row = 0;
+	for (int col = 0; col < nCols && row < nRows; col += LU_BLOCK_SIZE) {
+		int lastCol = std::min (col + LU_BLOCK_SIZE, nCols);
+		int firstPivot = pivotCols_.size ();
+		int nextRow = FactorizePanel (row, col, lastCol);
+		if (nextRow != row && lastCol < nCols) {
+			UpdateTrailing (row, nextRow, firstPivot, lastCol);
+		}
+		row = nextRow;
+	}
+	rank_ = row;
+}
+
+template <typename T>
+int Linear::LU <T>::FactorizePanel (int firstRow, int firstCol, int lastCol) {
+	//	Eliminates columns [firstCol, lastCol) only; rows are swapped whole.
+	//	Returns the row after the last pivot found.
+	int nRows = factors_.Shape ().first;
+	int row = firstRow;
+	for (int col = firstCol; col < lastCol && row < nRows; ++col) {
+		int maxIdx = row;
+		for (int i = row + 1; i < nRows; ++i) {
+			if (std::fabs (factors_ (i, col)) > std::fabs (factors_ (maxIdx, col))) {
+				maxIdx = i;
+			}
+		}
+		if (std::fabs (factors_ (maxIdx, col)) < EPS) {
+			//	No pivot in this column
+			continue;
+		}
+		if (maxIdx != row) {
+			factors_.SwapRows (row, maxIdx);
+			std::swap (permutation_[row], permutation_[maxIdx]);
+			sign_ = -sign_;
+		}
+		pivotCols_.push_back (col);
+		const T* pivotRow = factors_.Row (row);
+		for (int i = row + 1; i < nRows; ++i) {
+			T* current = factors_.Row (i);
+			T factor = current[col] / pivotRow[col];
+			current[col] = factor;
+			Rows::Axpy (lastCol - col - 1, -factor, pivotRow + col + 1, current + col + 1);
+		}
+		++row;
+	}
+	return row;
+}
+
+template <typename T>
+void Linear::LU <T>::UpdateTrailing (int firstRow, int lastRow, int firstPivot, int firstCol) {
+	//	Applies the panel pivots (rows [firstRow, lastRow)) to every column from firstCol on
+	int nRows = factors_.Shape ().first, nCols = factors_.Shape ().second;
+	int nPivots = lastRow - firstRow, width = nCols - firstCol;
+
+	//	U12 = L11^-1 * A12
+	for (int s = 1; s < nPivots; ++s) {
+		T* current = factors_.Row (firstRow + s) + firstCol;
+		for (int t = 0; t < s; ++t) {
+			T factor = factors_ (firstRow + s, pivotCols_[firstPivot + t]);
+			Rows::Axpy (width, -factor, factors_.Row (firstRow + t) + firstCol, current);
+		}
+	}
+
+	//	A22 -= L21 * U12, L21 copied out because skipped columns may separate its pivots
+	int height = nRows - lastRow;
+	if (height == 0) {
+		return;
+	}
+	std::vector <T> lower (height * nPivots);
+	for (int i = 0; i < height; ++i) {
+		for (int t = 0; t < nPivots; ++t) {
+			lower[i * nPivots + t] = factors_ (lastRow + i, pivotCols_[firstPivot + t]);
+		}
+	}
+	auto upper = factors_.View ().Block (firstRow, firstCol, nPivots, width);
+	auto update = [&] (int begin, int end) {
+		MatrixView <const T> panel { lower.data () + begin * nPivots, end - begin, nPivots, nPivots };
+		MultiplyAdd (panel, upper, factors_.View ().Block (lastRow + begin, firstCol, end - begin, width), true);
+	};
+	if (static_cast <long long> (height) * width * nPivots < LU_PARALLEL_SIZE || Parallel::Current () == Parallel::Policy::SEQUENTIAL) {
+		update (0, height);
+	}
+	else {
+		//	The bands are already one per thread, GEMM inside them stays on its thread
+		Parallel::Pool ().ParallelFor (0, height, LU_PARALLEL_ROWS, [&] (int begin, int end) {
+			Parallel::Scope sequential { Parallel::Policy::SEQUENTIAL };
+			update (begin, end);
+		});
+	}
+}
+
+template <typename T>
+void Linear::LU <T>::CheckInvertible () const {
+	auto shape = factors_.Shape ();
+	if (shape.first != shape.second) {
+		throw (std::invalid_argument ("Matrix is not square."));
+	}
+	if (IsSingular ()) {
+		throw (std::runtime_error ("Matrix is singular."));
+	}
+}
+
+template <typename T>
+Linear::PairInt Linear::LU <T>::Shape () const {
+	return factors_.Shape ();
+}
+
+template <typename T>
+int Linear::LU <T>::Rank () const {
+	return rank_;
+}
+
+template <typename T>
+int Linear::LU <T>::Sign () const {
+	return sign_;
+}
+
+template <typename T>
+bool Linear::LU <T>::IsSingular () const {
+	return rank_ < std::min <int> (factors_.Shape ().first, factors_.Shape ().second);
+}
+
+template <typename T>
+const std::vector <int>& Linear::LU <T>::Permutation () const {
+	return permutation_;
+}
+
+template <typename T>
+const std::vector <int>& Linear::LU <T>::PivotCols () const {
+	return pivotCols_;
+}
+
+template <typename T>
+const Linear::Matrix <T>& Linear::LU <T>::Factors () const {
+	return factors_;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::LU <T>::L () const {
+	int nRows = factors_.Shape ().first;
+	Matrix <T> ans { nRows, nRows };
+	for (int i = 0; i < nRows; ++i) {
+		for (int t = 0; t < std::min (i, rank_); ++t) {
+			ans (i, t) = factors_ (i, pivotCols_[t]);
+		}
+		ans (i, i) = static_cast <T> (1);
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::LU <T>::U () const {
+	int nRows = factors_.Shape ().first, nCols = factors_.Shape ().second;
+	Matrix <T> ans { nRows, nCols };
+	for (int i = 0; i < rank_; ++i) {
+		std::copy (factors_.Row (i) + pivotCols_[i], factors_.Row (i) + nCols, ans.Row (i) + pivotCols_[i]);
+	}
+	return ans;
+}
+
+template <typename T>
+T Linear::LU <T>::Determinant () const {
+	auto shape = factors_.Shape ();
+	if (shape.first != shape.second) {
+		throw (std::invalid_argument ("Trying to calcute non-square matrix determinant."));
+	}
+	if (IsSingular ()) {
+		return T {};
+	}
+	T ans = static_cast <T> (sign_);
+	for (int i = 0; i < shape.first; ++i) {
+		ans *= factors_ (i, i);
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::LU <T>::Solve (const Matrix <T>& rhs) const {
+	//	Every column of rhs is a separate right-hand side
+	CheckInvertible ();
+	int n = factors_.Shape ().first, k = rhs.Shape ().second;
+	if (rhs.Shape ().first != n) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	Matrix <T> ans { n, k };
+	for (int i = 0; i < n; ++i) {
+		std::copy (rhs.Row (permutation_[i]), rhs.Row (permutation_[i]) + k, ans.Row (i));
+	}
+	//	L * Y = P * B
+	for (int i = 0; i < n; ++i) {
+		for (int t = 0; t < i; ++t) {
+			Rows::Axpy (k, -factors_ (i, t), ans.Row (t), ans.Row (i));
+		}
+	}
+	//	U * X = Y
+	for (int i = n - 1; i >= 0; --i) {
+		for (int t = i + 1; t < n; ++t) {
+			Rows::Axpy (k, -factors_ (i, t), ans.Row (t), ans.Row (i));
+		}
+		Rows::Scale (k, static_cast <T> (1) / factors_ (i, i), ans.Row (i));
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::LU <T>::Inverse () const {
+	CheckInvertible ();
+	return Solve (Matrix <T>::Eye (factors_.Shape ().first));
+}
+
+template <typename T>
+Linear::LU <T> Linear::Matrix <T>::Factorize () const {
+	return LU <T> { *this };
+}
@@ -7,20 +7,16 @@ double Linear::Determinant::Gauss (const Linear::Matrix <double>& matrix) {
 		throw (std::invalid_argument ("Trying to calcute non-square matrix determinant."));
 	}
 	if (nRows == 1) {
-		return matrix.At (0, 0);
+		return matrix (0, 0);
 	}
 	else {
-		double ans = 1.0;
-		int gaussFactor = 1;
-		Linear::Matrix <double> temp = matrix;
-		temp.DirectGauss (&gaussFactor);
-		ans *= gaussFactor;
-
-		for (int i = 0; i < nRows; ++i) {
-			ans *= temp.At (i, i);
-		}
+		double ans = matrix.Factorize ().Determinant ();
 		ans = (std::fabs (ans) < EPS ? 0 : ans);
 		//return std::round (ans);
 		return ans;
 	}
-}
\ No newline at end of file
+}
+
+double Linear::Determinant::Gauss (const Linear::MatrixView <const double>& matrix) {
+	return Gauss (Linear::Matrix <double> { matrix });
+}
@@ -2,14 +2,35 @@
 
 //	SYSTEM
 #include <iostream>
+#include <sstream>
 #include <vector>
+#include <numeric>
 #include <cmath>
 #include <iomanip>
 #include <exception>
+#include <type_traits>
+#include <limits>
+#include <atomic>
+#include <functional>
 
 //	BUFFER
 #include "Buffer.hpp"
 
+//	KERNELS
+#include "Gemm.hpp"
+#include "RowKernels.hpp"
+#include "Transposition.hpp"
+
+//	EXACT ELEMENTS
+#include "BigInt.hpp"
+
+//	EXPRESSIONS AND VIEWS
+#include "Expression.hpp"
+#include "MatrixView.hpp"
+
+//	THREADS
+#include "../Parallel/ThreadPool.hpp"
+
 //	SETTINGS
 #include "../Settings/Settings.hpp"
 
@@ -24,18 +45,47 @@ namespace Linear {
 	template <typename T>
 	class Matrix;
 
+	template <typename T>
+	class LU;
+
+	template <typename T>
+	class QR;
+
 	namespace Determinant {
 		//	DETERMINANT TYPES
 		enum class Type {
 			ERROR = 0,
 			FULL = 1,
-			GAUSS = 2
+			GAUSS = 2,
+			BAREISS = 3
 		};
 
 		//	REALIZATION
 		template <typename T>
 		T Full (const Linear::Matrix <T>& matrix);
+		template <typename T>
+		std::remove_const_t <T> Full (const Linear::MatrixView <T>& matrix);
 	    double Gauss (const Linear::Matrix <double>& matrix);
+	    double Gauss (const Linear::MatrixView <const double>& matrix);
+		//	Fraction-free elimination, O(n^3): exact for integer and BigInt elements
+		template <typename T>
+		T Bareiss (const Linear::Matrix <T>& matrix);
+		template <typename T>
+		std::remove_const_t <T> Bareiss (const Linear::MatrixView <T>& matrix);
+
+		//	Element types Bareiss works for: signed integers and BigInt, where every division
+		//	it makes is exact, and floating point, where it is ordinary elimination
+		template <typename T>
+		struct FractionFree : std::integral_constant <bool, std::is_signed <T>::value || std::is_same <T, BigInt>::value> {};
+
+		//	The type Bareiss forms a * d - b * c in, so that no step overflows before the
+		//	exact division brings the value back into range
+		template <typename T>
+		struct Wider { using Type = T; };
+		template <>
+		struct Wider <int> { using Type = long long; };
+		template <>
+		struct Wider <long long> { using Type = __int128; };
 	}
 
 	template <typename T>
@@ -43,54 +93,80 @@ namespace Linear {
 		private:
 			//	DATA
 			int nRows_ = 0, nCols_ = 0;
+			//	Distance between the starts of neighbouring rows, nCols_ or more (see Stride)
+			int ld_ = 0;
 			using MatrixBuffer <T>::size_;
 			using MatrixBuffer <T>::used_;
 			using MatrixBuffer <T>::data_;
+			using MatrixBuffer <T>::resource_;
+			using MatrixBuffer <T>::Grow;
 
 			//	AUXILIARY METHODS
 			void ReverseGauss 	(bool skipAdditional) &;
+			void CheckBounds 	(int i, int j) const;
+			//	Contents and buffers, resources included
+			void Swap 			(Matrix& rhs);
+			static int Stride 	(int cols);
+			//	body (begin, end) over ranges of rows, split between threads by policy
+			void ForRows 		(Parallel::Policy policy, const std::function <void (int, int)>& body) const;
 		public:
 			//	CTORS AND DTORS
-						Matrix 	(int rows, int cols, T value = T{});
+			//	The buffer comes from resource, which must outlive the matrix (see Buffer.hpp)
+						Matrix 	(int rows, int cols, T value = T{}, std::pmr::memory_resource* resource = Memory::Current ());
 			explicit	Matrix  (int rows = 0):
 							Matrix (rows, rows)
 							{}
 						~Matrix () = default;
 
 			//	CTOR FROM VECTOR
-			Matrix (int rows, int cols, std::vector <T> &vec);
+			Matrix (int rows, int cols, std::vector <T> &vec, std::pmr::memory_resource* resource = Memory::Current ());
 
 			//	CTORS FROM ANOTHER MATRIX
+			//	A copy takes Memory::Current () unless given a resource, a move keeps the one of rhs
 			Matrix (const Matrix& rhs);
+			Matrix (const Matrix& rhs, std::pmr::memory_resource* resource);
 			Matrix (Matrix&& rhs);
 
+			//	CTOR FROM EXPRESSION, evaluated in one pass
+			template <typename E>
+			Matrix (const Expression::Node <E>& expression, std::pmr::memory_resource* resource = Memory::Current ());
+
 			//	OVERLOADED OPERATORS AND METHODS
+			//	Assignment keeps the resource of *this
 			Matrix& operator = 	(const Matrix& rhs);
 			Matrix& operator = 	(Matrix&& rhs);
 			bool 	operator == (const Matrix& rhs) const;
+			bool 	Equals 		(const Matrix& rhs, Parallel::Policy policy = Parallel::Current ()) const;
 			bool 	operator != (const Matrix& rhs) const;
 			Matrix& operator *= (const T number) 	&;
 			Matrix& operator *= (const Matrix& rhs) &;
 			Matrix& operator += (const Matrix& rhs) &;
 			Matrix& operator -= (const Matrix& rhs) &;
+			template <typename E>
+			Matrix& operator = 	(const Expression::Node <E>& expression);
+			template <typename E>
+			Matrix& operator += (const Expression::Node <E>& expression) &;
+			template <typename E>
+			Matrix& operator -= (const Expression::Node <E>& expression) &;
 			operator std::vector <T>  ();
 			void Resize 	(PairInt shape) &;
-			void Transpose 	() &;
+			void Transpose 	(Parallel::Policy policy = Parallel::Current ()) &;
 			void Negate 	() &;
 			void Clear 		() &;
 			void Diagonalize (bool skipAdditional = false) &;
 
 			//	AUXILIARY FOR RANK AND DETERMINANT
-			void DirectGauss 	(int *gaussFactor = nullptr) &;
+			void DirectGauss 	(int *gaussFactor = nullptr, Parallel::Policy policy = Parallel::Current ()) &;
 			void MakeEye 		(bool skipAdditional = false) &;
 
 			//	ROW AND COLUMN OPERATIONS
 			void SwapRows 	(int lhs, int rhs);
 			void AddRows	(int source, int destination, T factor);
-			void AppendRows	(Matrix <T>& additional, bool inFront = false);
+			void MultiplyRow (int row, T factor);
+			void AppendRows	(const Matrix <T>& additional, bool inFront = false);
 			void SwapCols 	(int lhs, int rhs);
 			void AddCols 	(int source, int destination, T factor);
-			void AppendCols	(Matrix <T>& additional, bool inFront = false);
+			void AppendCols	(const Matrix <T>& additional, bool inFront = false);
 
 			//	BASIC TYPES
 			static Matrix Zeros (int n);
@@ -99,16 +175,38 @@ namespace Linear {
 			//	GETTERS
 			PairInt 	Shape		() const;
 			int 		Size 		() const;
+			int 		Capacity 	() const;
+			//	Distance between row starts. The buffer always starts on MATRIX_ALIGNMENT bytes, but
+			//	only rows of at least MATRIX_PAD_MIN_BYTES are padded: in narrower matrices rows
+			//	follow each other and are aligned only when their length is a multiple of it
+			int 		LeadingDimension () const;
+			using 		MatrixBuffer <T>::Resource;
 			T 			Trace 		() const;
 			const T& 	At 			(int i, int j) const;
 			void 		Dump 		(std::ostream& stream) const;
 
+			//	UNCHECKED GETTERS FOR INTERNAL ALGORITHMS
+			const T& 	operator () (int i, int j) const;
+			const T* 	Row 		(int i) const;
+
 			//	SETTERS
 			T& At (int i, int j);
 
+			//	UNCHECKED SETTERS FOR INTERNAL ALGORITHMS
+			T& operator () (int i, int j);
+			T* Row (int i);
+
+			//	VIEWS, see MatrixView.hpp
+			MatrixView <T> 			View () &;
+			MatrixView <const T> 	View () const &;
+			MatrixView <const T> 	View () && = delete;
+
 			//	ALGEBRA
 			T Determinant (Determinant::Type type = Determinant::Type::ERROR) const;
+			//	Numerical rank, from the column-pivoted QR
 			int Rank () const;
+			LU <T> Factorize () const;
+			QR <T> FactorizeQR () const;
 	};
 
 	//	INPUT AND OUTPUT
@@ -118,81 +216,236 @@ namespace Linear {
 	std::ostream& operator << (std::ostream& stream, const Matrix <T>& rhs);
 
 	//	OVERLOADED OPERATORS
-	template <typename T>
-	Matrix <T> operator + (const Matrix <T>& lhs, const Matrix <T>& rhs);
-	template <typename T>
-	Matrix <T> operator - (const Matrix <T>& lhs, const Matrix <T>& rhs);
-	template <typename T>
-	Matrix <T> operator * (const T number, const Matrix <T>& rhs);
-	template <typename T>
-	Matrix <T> operator * (const Matrix <T>& lhs, const T number);
-	template <typename T>
-	Matrix <T> operator * (const Matrix <T>& lhs, const Matrix <T>& rhs);
+	//	+, -, * by a number and * by a matrix are in Expression.hpp
+}
+
+namespace Linear {
+	namespace Determinant {
+		//	Laplace expansion of rows [row, n) over the columns left in cols;
+		//	a minor is the next row and one column fewer, nothing is copied
+		template <typename T>
+		std::remove_const_t <T> FullMinor (const MatrixView <T>& matrix, int row, std::vector <int>& cols) {
+			if (cols.size () == 1) {
+				return matrix (row, cols[0]);
+			}
+			std::remove_const_t <T> ans {};
+			int nCols = cols.size ();
+			for (int i = 0; i < nCols; ++i) {
+				int col = cols[i];
+				cols.erase (cols.begin () + i);
+				//	Main sum
+				ans += ( i % 2 == 0 ? + 1 : - 1 ) * matrix (row, col) * FullMinor (matrix, row + 1, cols);
+				cols.insert (cols.begin () + i, col);
+			}
+			return ans;
+		}
+
+		//	Laplace expansion with every minor computed once: the minor on the first k rows
+		//	and the k columns in mask is table[mask], so n * 2^n steps instead of n!, and
+		//	the only allocation is the table.
+		//	Minors with k columns only read minors with k - 1, so from DETERMINANT_PARALLEL_SIZE
+		//	on each k is one parallel loop on Parallel::Pool (); the sums are the same either way.
+		template <typename T>
+		std::remove_const_t <T> FullMasks (const MatrixView <T>& matrix) {
+			using Value = std::remove_const_t <T>;
+			int n = matrix.Shape ().first;
+			unsigned full = (1u << n) - 1;
+			std::pmr::vector <Value> table (size_t { full } + 1, Memory::Current ());
+			auto minor = [&] (unsigned mask) {
+				int row = __builtin_popcount (mask) - 1;
+				if (row == 0) {
+					table[mask] = matrix (0, __builtin_ctz (mask));
+					return;
+				}
+				//	Along the last row: the sign is odd when an odd number of columns follow col
+				Value ans {};
+				for (unsigned rest = mask; rest; rest &= rest - 1) {
+					int col = __builtin_ctz (rest);
+					Value term = matrix (row, col) * table[mask ^ (1u << col)];
+					if (__builtin_popcount (mask >> (col + 1)) % 2 == 0) {
+						ans += term;
+					}
+					else {
+						ans -= term;
+					}
+				}
+				table[mask] = std::move (ans);
+			};
+
+			if (n < DETERMINANT_PARALLEL_SIZE || !Parallel::Splits (Parallel::Current (), PARALLEL_MIN_WORK)) {
+				for (unsigned mask = 1; mask <= full; ++mask) {
+					minor (mask);
+				}
+				return std::move (table[full]);
+			}
+			//	Masks sorted by the number of columns, those with k columns at [first[k], first[k + 1])
+			std::vector <int> first (n + 2, 0);
+			for (unsigned mask = 1; mask <= full; ++mask) {
+				++first[__builtin_popcount (mask) + 1];
+			}
+			std::partial_sum (first.begin (), first.end (), first.begin ());
+			std::vector <unsigned> masks (full);
+			std::vector <int> next (first.begin (), first.end () - 1);
+			for (unsigned mask = 1; mask <= full; ++mask) {
+				masks[next[__builtin_popcount (mask)]++] = mask;
+			}
+			for (int k = 1; k <= n; ++k) {
+				Parallel::Pool ().ParallelFor (first[k], first[k + 1], DETERMINANT_PARALLEL_MASKS,
+															 [&] (int begin, int end) {
+					for (int i = begin; i < end; ++i) {
+						minor (masks[i]);
+					}
+				});
+			}
+			return std::move (table[full]);
+		}
+	}
 }
 
 template <typename T>
-T Linear::Determinant::Full (const Linear::Matrix <T>& matrix) {
+std::remove_const_t <T> Linear::Determinant::Full (const Linear::MatrixView <T>& matrix) {
 	auto shape = matrix.Shape ();
 	int nRows = shape.first, nCols = shape.second;
 	if (nRows != nCols) {
 		throw (std::invalid_argument ("Trying to calcute non-square matrix determinant."));
 	}
-	if (nRows == 1) {
-		return matrix.At (0, 0);
+	if (nRows == 0) {
+		return std::remove_const_t <T> {};
 	}
-	else {
-		T ans {};
-		for (int i = 0; i < nCols; ++i) {
-			Linear::Matrix <T> temp { nRows - 1, nCols - 1 };
-			//	Creating minor
-			for (int j = 0; j < nRows - 1; ++j) {
-				for (int k = 0; k < nCols; ++k) {
-					if (k < i) {
-						temp.At (j, k) = matrix.At (j + 1, k);
-					}
-					else if (k == i) {
-						continue;
-					}
-					else {
-						temp.At (j, k - 1) = matrix.At (j + 1, k);
+	if constexpr (FractionFree <std::remove_const_t <T>>::value) {
+		if (nRows > DETERMINANT_LAPLACE_MAX_SIZE) {
+			return Bareiss (matrix);
+		}
+	}
+	if (nRows <= DETERMINANT_MASK_MAX_SIZE) {
+		return FullMasks (matrix);
+	}
+	std::vector <int> cols (nCols);
+	std::iota (cols.begin (), cols.end (), 0);
+	return FullMinor (matrix, 0, cols);
+}
+
+template <typename T>
+T Linear::Determinant::Full (const Linear::Matrix <T>& matrix) {
+	return Full (matrix.View ());
+}
+
+template <typename T>
+std::remove_const_t <T> Linear::Determinant::Bareiss (const Linear::MatrixView <T>& matrix) {
+	using Value = std::remove_const_t <T>;
+	using Wide = typename Wider <Value>::Type;
+	auto shape = matrix.Shape ();
+	int n = shape.first;
+	if (n != shape.second) {
+		throw (std::invalid_argument ("Trying to calcute non-square matrix determinant."));
+	}
+	if (n == 0) {
+		return Value {};
+	}
+	Matrix <Value> work { matrix };
+	Value previous = static_cast <Value> (1);
+	bool negative = false;
+	for (int k = 0; k < n - 1; ++k) {
+		//	Any non-zero pivot keeps the divisions exact; floating point takes the largest
+		int pivot = -1;
+		for (int i = k; i < n; ++i) {
+			if (work (i, k) == Value {}) {
+				continue;
+			}
+			if constexpr (std::is_floating_point <Value>::value) {
+				if (pivot == -1 || std::fabs (work (i, k)) > std::fabs (work (pivot, k))) {
+					pivot = i;
+				}
+			}
+			else {
+				pivot = i;
+				break;
+			}
+		}
+		if (pivot == -1) {
+			return Value {};
+		}
+		if (pivot != k) {
+			work.SwapRows (pivot, k);
+			negative = !negative;
+		}
+		//	Every (i, j) becomes a (k + 2) x (k + 2) minor of the matrix, divided exactly
+		const Value& diagonal = work (k, k);
+		for (int i = k + 1; i < n; ++i) {
+			Value* row = work.Row (i);
+			const Value* pivotRow = work.Row (k);
+			for (int j = k + 1; j < n; ++j) {
+				if constexpr (std::is_same <Wide, Value>::value) {
+					Value value = diagonal * row[j];
+					value -= row[k] * pivotRow[j];
+					value /= previous;
+					row[j] = std::move (value);
+				}
+				else {
+					Wide value = (Wide (diagonal) * Wide (row[j]) - Wide (row[k]) * Wide (pivotRow[j])) / Wide (previous);
+					if (value < std::numeric_limits <Value>::min () || value > std::numeric_limits <Value>::max ()) {
+						throw (std::overflow_error ("Determinant overflows the matrix element type."));
 					}
+					row[j] = static_cast <Value> (value);
 				}
 			}
-			//	Main sum
-			ans += ( i % 2 == 0 ? + 1 : - 1 ) * matrix.At (0, i) * Determinant::Full (temp);
 		}
-		//ans = (std::fabs (ans) < EPS ? 0 : ans);
-		//return std::round (ans);
-		return ans;
+		previous = diagonal;
 	}
+	return (negative ? -work (n - 1, n - 1) : work (n - 1, n - 1));
+}
+
+template <typename T>
+T Linear::Determinant::Bareiss (const Linear::Matrix <T>& matrix) {
+	return Bareiss (matrix.View ());
 }
 
 template <typename T>
 void Linear::Matrix <T>::ReverseGauss (bool skipAdditional) & {
 	int columnStartValue = (nCols_ - 1) - (skipAdditional ? 1 : 0);
     for (int i = std::min (nRows_ - 1, columnStartValue) ; i >= 0; --i) {
-        if (std::fabs (At (i, i)) >= EPS) {
+        if (std::fabs ((*this) (i, i)) >= EPS) {
             for (int j = i - 1; j >= 0; --j) {
-		    	AddRows (i, j, (- 1) * (At (j, i) / At (i, i)));
+		    	AddRows (i, j, (- 1) * ((*this) (j, i) / (*this) (i, i)));
 		    }
         }
     }
 }
 
 template <typename T>
-Linear::Matrix <T>::Matrix (int rows, int cols, T value):
-	MatrixBuffer <T> (rows * cols),
+int Linear::Matrix <T>::Stride (int cols) {
+	//	Wide rows are padded to whole MATRIX_ALIGNMENT blocks, so that every row starts aligned;
+	//	narrow rows are not, the padding would be a large part of them
+#ifndef MATRIX_NO_PADDING
+	if (MATRIX_ALIGNMENT % sizeof (T) == 0 && cols > 0 && cols * sizeof (T) >= MATRIX_PAD_MIN_BYTES) {
+		int block = MATRIX_ALIGNMENT / sizeof (T);
+		return (cols + block - 1) / block * block;
+	}
+#endif
+	return cols;
+}
+
+template <typename T>
+void Linear::Matrix <T>::ForRows (Parallel::Policy policy, const std::function <void (int, int)>& body) const {
+	Parallel::For (policy, 0, nRows_, 1, static_cast <long long> (nRows_) * nCols_, body);
+}
+
+template <typename T>
+Linear::Matrix <T>::Matrix (int rows, int cols, T value, std::pmr::memory_resource* resource):
+	MatrixBuffer <T> (rows * Stride (cols), resource),
 	nRows_ (rows),
-	nCols_ (cols)
+	nCols_ (cols),
+	ld_ (Stride (cols))
 	{
 		if (nRows_ < 0 || nCols_ < 0) {
 			throw std::invalid_argument ("Wrong number of rows / columns in ctor");
 		}
 		else if (nRows_ * nCols_ == 0) {
-			nRows_ = nCols_ = 0;
+			nRows_ = nCols_ = ld_ = 0;
 		}
 		else {
-			for (int i = 0; i < nRows_ * nCols_; ++i) {
+			//	Padding is constructed too, every buffer holds nRows_ * ld_ elements
+			for (int i = 0; i < nRows_ * ld_; ++i) {
 				new (data_ + i) T { value };
 				++used_;
 			}
@@ -200,24 +453,30 @@ Linear::Matrix <T>::Matrix (int rows, int cols, T value):
 	}
 
 template <typename T>
-Linear::Matrix <T>::Matrix (int rows, int cols, std::vector <T> &vec):
-	Matrix (rows, cols)
+Linear::Matrix <T>::Matrix (int rows, int cols, std::vector <T> &vec, std::pmr::memory_resource* resource):
+	Matrix (rows, cols, T {}, resource)
 	{
 		if (vec.size () != nRows_ * nCols_) {
 			throw (std::invalid_argument ("Vector and Matrix sizes do not match."));
 		}
-		for (int pos = 0; pos < std::min <int> (nRows_ * nCols_, vec.size ()); ++pos) {
-			At (pos / nCols_, pos % nCols_) = vec [pos];
+		for (int i = 0; i < nRows_; ++i) {
+			std::copy (vec.begin () + i * nCols_, vec.begin () + (i + 1) * nCols_, Row (i));
 		}
 	}
 
 template <typename T>
 Linear::Matrix <T>::Matrix (const Matrix& rhs):
-	MatrixBuffer <T> (rhs.nRows_ * rhs.nCols_),
+	Matrix (rhs, Memory::Current ())
+	{}
+
+template <typename T>
+Linear::Matrix <T>::Matrix (const Matrix& rhs, std::pmr::memory_resource* resource):
+	MatrixBuffer <T> (rhs.nRows_ * rhs.ld_, resource),
 	nRows_ (rhs.nRows_),
-	nCols_ (rhs.nCols_)
+	nCols_ (rhs.nCols_),
+	ld_ (rhs.ld_)
 	{
-		for (int i = 0; i < nRows_ * nCols_; ++i) {
+		for (int i = 0; i < nRows_ * ld_; ++i) {
 			new (data_ + i) T { rhs.data_[i] };
 			++used_;
 		}
@@ -225,43 +484,66 @@ Linear::Matrix <T>::Matrix (const Matrix& rhs):
 
 template <typename T>
 Linear::Matrix <T>::Matrix (Matrix&& rhs) {
-	std::swap (nRows_, rhs.nRows_);	
+	Swap (rhs);
+}
+
+template <typename T>
+void Linear::Matrix <T>::Swap (Matrix& rhs) {
+	std::swap (nRows_, rhs.nRows_);
 	std::swap (nCols_, rhs.nCols_);
+	std::swap (ld_, rhs.ld_);
 	MatrixBuffer <T>::Swap (rhs);
 }
 
 template <typename T>
 Linear::Matrix <T>& Linear::Matrix <T>::operator = (const Matrix& rhs) {
 	if (this != &rhs) {
-		Matrix temp { rhs };
-		std::swap (*this, temp);
+		Matrix temp { rhs, resource_ };
+		Swap (temp);
 	}
 	return *this;
 }
 
 template <typename T>
 Linear::Matrix <T>& Linear::Matrix <T>::operator = (Matrix&& rhs) {
-	if (this != &rhs) {
-		std::swap (nRows_, rhs.nRows_);	
-		std::swap (nCols_, rhs.nCols_);
-		MatrixBuffer <T>::Swap (rhs);
+	if (this == &rhs) {
+		return *this;
+	}
+	if (*resource_ == *rhs.resource_) {
+		Swap (rhs);
+	}
+	else {
+		//	The buffer of rhs cannot be taken over: it goes back to another resource
+		Matrix temp { rhs, resource_ };
+		Swap (temp);
 	}
 	return *this;
 }
 
 template <typename T>
 bool Linear::Matrix <T>::operator == (const Matrix& rhs) const {
+	return Equals (rhs);
+}
+
+template <typename T>
+bool Linear::Matrix <T>::Equals (const Matrix& rhs, Parallel::Policy policy) const {
 	if (Shape () != rhs.Shape()) {
 		return false;
 	}
-	for (int i = 0; i < nRows_; ++i) {
-		for (int j = 0; j < nCols_; ++j) {
-			if (At (i, j) != rhs.At (i, j)) {
-				return false;
+	std::atomic <bool> equal { true };
+	ForRows (policy, [&] (int begin, int end) {
+		for (int i = begin; i < end && equal.load (std::memory_order_relaxed); ++i) {
+			const T* lhsRow = Row (i);
+			const T* rhsRow = rhs.Row (i);
+			for (int j = 0; j < nCols_; ++j) {
+				if (lhsRow[j] != rhsRow[j]) {
+					equal = false;
+					return;
+				}
 			}
 		}
-	}
-	return true;
+	});
+	return equal;
 }
 
 template <typename T>
@@ -272,109 +554,252 @@ bool Linear::Matrix <T>::operator != (const Matrix& rhs) const {
 template <typename T>
 Linear::Matrix <T>& Linear::Matrix <T>::operator *= (const T number) & { 
 	//	MULTIPLY BY THE NUMBER (OF THE SAME TYPE)
-	for (int i = 0; i < nRows_; ++i) {
-		for (int j = 0; j < nCols_; ++j) {
-			At (i, j) *= number;
+	ForRows (Parallel::Current (), [&] (int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			Rows::Scale (nCols_, number, Row (i));
 		}
-	}
+	});
 	return *this;
 }
 
 template <typename T>
 Linear::Matrix <T>& Linear::Matrix <T>::operator *= (const Matrix& rhs) & {	
 	// MULTIPLY BY ANOTHER MATRIX (OF THE SAME TYPE)
-	if (this->nCols_ != rhs.nRows_) {
-		throw (std::invalid_argument ("Trying to multiply by a matrix with inappropriate size."));
+	*this = *this * rhs;
+	return *this;
+}
+
+template <typename T>
+Linear::Matrix <T>& Linear::Matrix <T>::operator += (const Matrix& rhs) & {
+	if (Shape () != rhs.Shape ()) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
 	}
 	else {
-		Matrix <T> ans { this->nRows_, rhs.nCols_ };
-		for (int i = 0; i < this->nRows_; ++i) {
-			for (int j = 0; j < rhs.nCols_; ++j) {
-				for (int k = 0; k < this->nCols_; ++k) {
-					ans.At (i, j)+= At (i, k) * rhs.At (k, j);
-				}
+		ForRows (Parallel::Current (), [&] (int begin, int end) {
+			for (int i = begin; i < end; ++i) {
+				Rows::Axpy (nCols_, static_cast <T> (1), rhs.Row (i), Row (i));
 			}
-		}
-		*this = std::move (ans);
+		});
 	}
 	return *this;
 }
 
 template <typename T>
-Linear::Matrix <T>& Linear::Matrix <T>::operator += (const Matrix& rhs) & {
+Linear::Matrix <T>& Linear::Matrix <T>::operator -= (const Matrix& rhs) & {
 	if (Shape () != rhs.Shape ()) {
 		throw (std::invalid_argument ("Matrix sizes do not match."));
 	}
 	else {
-		for (int i = 0; i < nRows_; ++i) {
-			for (int j = 0; j < nCols_; ++j) {
-				At (i, j) += rhs.At (i, j);
+		ForRows (Parallel::Current (), [&] (int begin, int end) {
+			for (int i = begin; i < end; ++i) {
+				T* lhsRow = Row (i);
+				const T* rhsRow = rhs.Row (i);
+				for (int j = 0; j < nCols_; ++j) {
+					lhsRow[j] -= rhsRow[j];
+				}
+			}
+		});
+	}
+	return *this;
+}
+
+template <typename T>
+template <typename E>
+Linear::Matrix <T>::Matrix (const Expression::Node <E>& expression, std::pmr::memory_resource* resource):
+	MatrixBuffer <T> (expression.Self ().Shape ().first * Stride (expression.Self ().Shape ().second), resource),
+	nRows_ (expression.Self ().Shape ().first),
+	nCols_ (expression.Self ().Shape ().second),
+	ld_ (Stride (expression.Self ().Shape ().second))
+	{
+		const E& node = expression.Self ();
+		if constexpr (std::is_trivially_destructible <T>::value) {
+			//	Nothing to destroy if a row throws, so rows are built in any order
+			ForRows (Parallel::Current (), [&] (int begin, int end) {
+				for (int i = begin; i < end; ++i) {
+					for (int j = 0; j < ld_; ++j) {
+						new (data_ + i * ld_ + j) T { j < nCols_ ? node (i, j) : T {} };
+					}
+				}
+			});
+			used_ = nRows_ * ld_;
+		}
+		else {
+			for (int i = 0; i < nRows_; ++i) {
+				for (int j = 0; j < ld_; ++j) {
+					new (data_ + i * ld_ + j) T { j < nCols_ ? node (i, j) : T {} };
+					++used_;
+				}
 			}
 		}
 	}
+
+template <typename T>
+template <typename E>
+Linear::Matrix <T>& Linear::Matrix <T>::operator = (const Expression::Node <E>& expression) {
+	//	Elementwise nodes read (i, j) only to write (i, j), so an operand may be *this
+	const E& node = expression.Self ();
+	if (node.Shape () != Shape ()) {
+		*this = Matrix <T> { expression, resource_ };
+		return *this;
+	}
+	ForRows (Parallel::Current (), [&] (int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			T* row = Row (i);
+			for (int j = 0; j < nCols_; ++j) {
+				row[j] = node (i, j);
+			}
+		}
+	});
 	return *this;
 }
 
 template <typename T>
-Linear::Matrix <T>& Linear::Matrix <T>::operator -= (const Matrix& rhs) & {
-	if (Shape () != rhs.Shape ()) {
+template <typename E>
+Linear::Matrix <T>& Linear::Matrix <T>::operator += (const Expression::Node <E>& expression) & {
+	const E& node = expression.Self ();
+	if (node.Shape () != Shape ()) {
 		throw (std::invalid_argument ("Matrix sizes do not match."));
 	}
-	else {
-		for (int i = 0; i < nRows_; ++i) {
+	ForRows (Parallel::Current (), [&] (int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			T* row = Row (i);
 			for (int j = 0; j < nCols_; ++j) {
-				At (i, j) -= rhs.At (i, j);
+				row[j] += node (i, j);
 			}
 		}
+	});
+	return *this;
+}
+
+template <typename T>
+template <typename E>
+Linear::Matrix <T>& Linear::Matrix <T>::operator -= (const Expression::Node <E>& expression) & {
+	const E& node = expression.Self ();
+	if (node.Shape () != Shape ()) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
 	}
+	ForRows (Parallel::Current (), [&] (int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			T* row = Row (i);
+			for (int j = 0; j < nCols_; ++j) {
+				row[j] -= node (i, j);
+			}
+		}
+	});
 	return *this;
 }
 
 template <typename T>
 Linear::Matrix <T>::operator std::vector <T> () {
 	std::vector <T> ans {};
+	ans.reserve (nRows_ * nCols_);
 	for (int i = 0; i < nRows_; ++i) {
-		for (int j = 0; j < nCols_; ++j) {
-			ans.push_back (At (i, j));
-		}
+		ans.insert (ans.end (), Row (i), Row (i) + nCols_);
 	}
 	return ans;
 }
 
 template <typename T>
 void Linear::Matrix <T>::Resize (PairInt shape) & {
-	Matrix <T> ans { shape.first, shape.second };
-	for (int i = 0; i < std::min <int> (shape.first, nRows_); ++i) {
-		for (int j = 0; j < std::min <int> (shape.second, nCols_); ++j) {
-			ans.At (i, j) = At (i, j);
+	//	Elements stay in this buffer (grown geometrically if needed) and are moved, not copied.
+	//	Adding or removing rows touches only those rows, changing columns moves every row.
+	int nRows = shape.first, nCols = shape.second;
+	if (nRows < 0 || nCols < 0) {
+		throw std::invalid_argument ("Wrong number of rows / columns in Resize");
+	}
+	if (nRows * nCols == 0) {
+		nRows = nCols = 0;
+	}
+	if (nRows == nRows_ && nCols == nCols_) {
+		return;
+	}
+	int ld = Stride (nCols), required = nRows * ld;
+	int keptRows = std::min (nRows, nRows_), keptCols = std::min (nCols, nCols_);
+	Grow (required);
+	while (used_ < required) {
+		new (data_ + used_) T {};
+		++used_;
+	}
+
+	if (ld < ld_) {
+		//	Rows move to the front, the first one stays
+		for (int i = 1; i < keptRows; ++i) {
+			std::move (data_ + i * ld_, data_ + i * ld_ + keptCols, data_ + i * ld);
+		}
+	}
+	else if (ld > ld_) {
+		//	Rows move to the back, the last one goes first
+		for (int i = keptRows - 1; i > 0; --i) {
+			std::move_backward (data_ + i * ld_, data_ + i * ld_ + keptCols, data_ + i * ld + keptCols);
 		}
 	}
-	*this = ans;
+	for (int i = 0; i < keptRows; ++i) {
+		std::fill (data_ + i * ld + keptCols, data_ + (i + 1) * ld, T {});
+	}
+	std::fill (data_ + keptRows * ld, data_ + required, T {});
+
+	while (used_ > required) {
+		data_[--used_].~T ();
+	}
+	nRows_ = nRows;
+	nCols_ = nCols;
+	ld_ = ld;
 }
 
 template <typename T>
-void Linear::Matrix <T>::Transpose () & {
-	Matrix <T> temp {nCols_, nRows_};
-	for (int i = 0; i < nRows_; ++i) {
-		for (int j = 0; j < nCols_; ++j) {
-			temp.At (j, i) = At (i, j);
+void Linear::Matrix <T>::Transpose (Parallel::Policy policy) & {
+	if (nRows_ == 1 || nCols_ == 1) {
+		//	A row and a column have the same layout, only the padding of a row differs
+		std::swap (nRows_, nCols_);
+		ld_ = Stride (nCols_);
+		int required = nRows_ * ld_;
+		Grow (required);
+		while (used_ < required) {
+			new (data_ + used_) T {};
+			++used_;
+		}
+		while (used_ > required) {
+			data_[--used_].~T ();
 		}
 	}
-	*this = std::move (temp);
+	else if (nRows_ == nCols_ && !Parallel::Splits (policy, Size ())) {
+		Transposition::Square (nRows_, data_, ld_);
+	}
+	else if (nRows_ == nCols_) {
+		//	Tile row p and its mirror nTiles - 1 - p together hold nTiles + 1 tiles,
+		//	so the pairs are equal pieces of work
+		int nTiles = (nRows_ + Transposition::TILE - 1) / Transposition::TILE;
+		Parallel::For (policy, 0, (nTiles + 1) / 2, 1, Size (), [&] (int begin, int end) {
+			for (int pair = begin; pair < end; ++pair) {
+				Transposition::SquareTiles (nRows_, data_, ld_, pair, pair + 1);
+				if (nTiles - 1 - pair != pair) {
+					Transposition::SquareTiles (nRows_, data_, ld_, nTiles - 1 - pair, nTiles - pair);
+				}
+			}
+		});
+	}
+	else {
+		Matrix <T> temp { nCols_, nRows_, T {}, resource_ };
+		//	Bands of source rows fill disjoint bands of columns of temp
+		ForRows (policy, [&] (int begin, int end) {
+			Transposition::Copy (end - begin, nCols_, data_ + begin * ld_, ld_, temp.data_ + begin, temp.ld_);
+		});
+		*this = std::move (temp);
+	}
 }
 
 template <typename T>
 void Linear::Matrix <T>::Negate () & {
-	for (int i = 0; i < nRows_; ++i) {
-		for (int j = 0; j < nCols_; ++j) {
-			At (i, j) = (- 1) * At (i, j);
+	ForRows (Parallel::Current (), [&] (int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			Rows::Scale (nCols_, static_cast <T> (- 1), Row (i));
 		}
-	}
+	});
 }
 
 template <typename T>
 void Linear::Matrix <T>::Clear () & {
-	*this = std::move (Matrix <T> {});
+	*this = Matrix <T> { 0, 0, T {}, resource_ };
 }
 
 template <typename T>
@@ -384,13 +809,13 @@ void Linear::Matrix <T>::Diagonalize (bool skipAdditional) & {
 }
 
 template <typename T>
-void Linear::Matrix <T>::DirectGauss (int *gaussFactor) & {
+void Linear::Matrix <T>::DirectGauss (int *gaussFactor, Parallel::Policy policy) & {
 	for (int i = 0; i < std::min <int> (nRows_, nCols_); ++i) {
-		T maxElement = At (i, i);
+		T maxElement = (*this) (i, i);
 		int maxIdx = i;
 		for (int j = i + 1; j < nRows_; ++j) {
-			if (std::fabs (At (j, i)) > std::fabs (maxElement)) {
-				maxElement = At (j, i);
+			if (std::fabs ((*this) (j, i)) > std::fabs (maxElement)) {
+				maxElement = (*this) (j, i);
 				maxIdx = j;
 			}
 		}
@@ -404,9 +829,13 @@ void Linear::Matrix <T>::DirectGauss (int *gaussFactor) & {
 			}
 			SwapRows (i, maxIdx);
 		}
-		for (int j = i + 1; j < nRows_; ++j) {
-			AddRows (i, j, (- 1) * (At (j, i) / At (i, i)));
-		}
+		//	Rows below the pivot only read row i
+		long long work = static_cast <long long> (nRows_ - i - 1) * nCols_;
+		Parallel::For (policy, i + 1, nRows_, 1, work, [&] (int begin, int end) {
+			for (int j = begin; j < end; ++j) {
+				AddRows (i, j, (- 1) * ((*this) (j, i) / (*this) (i, i)));
+			}
+		});
 	}
 }
 
@@ -415,11 +844,9 @@ void Linear::Matrix <T>::MakeEye (bool skipAdditional) & {
 	Diagonalize (skipAdditional);
 	int columnStartValue = (nCols_ - 1) - (skipAdditional ? 1 : 0);
     for (int i = std::min (nRows_ - 1, columnStartValue) ; i >= 0; --i) {
-        if (std::fabs (At (i, i)) >= EPS) {
-            T divisor = At (i, i);
-            for (int j = nCols_ - 1; j >= i; --j) {
-                At (i, j) /= divisor;
-            }
+        if (std::fabs ((*this) (i, i)) >= EPS) {
+            //	Everything left of the pivot is already eliminated
+            Rows::Divide (nCols_ - i, (*this) (i, i), Row (i) + i);
         }
     }
 }
@@ -430,9 +857,7 @@ void Linear::Matrix <T>::SwapRows (int lhs, int rhs) {
 		throw (std::invalid_argument ("Wrong lhs / rhs value."));
 	}
 	else {
-		for (int i = 0;  i < nCols_; ++i) {
-			std::swap (At (lhs, i), At (rhs, i));
-		}
+		Rows::Swap (nCols_, Row (lhs), Row (rhs));
 	}
 }
 
@@ -442,29 +867,49 @@ void Linear::Matrix <T>::AddRows (int source, int destination, T factor) {
 		throw (std::invalid_argument ("Wrong source / destination value."));
 	}
 	else {
-		for (int i = 0; i < nCols_; ++i) {
-			At (destination, i) += At (source, i) * factor;
-		}
+		Rows::Axpy (nCols_, factor, Row (source), Row (destination));
 	}
 }
 
 template <typename T>
-void Linear::Matrix <T>::AppendRows (Matrix <T>& additional, bool inFront) {
+void Linear::Matrix <T>::MultiplyRow (int row, T factor) {
+	if (row < 0 || row >= nRows_) {
+		throw (std::invalid_argument ("Wrong row value."));
+	}
+	else {
+		Rows::Scale (nCols_, factor, Row (row));
+	}
+}
+
+template <typename T>
+void Linear::Matrix <T>::AppendRows (const Matrix <T>& additional, bool inFront) {
 	if (additional.nCols_ != nCols_) {
 		throw std::invalid_argument ("Numbers of columns don't match!");
 	}
-    auto mainVec = static_cast <std::vector <T>> (*this);
-	auto additionalVec = static_cast <std::vector <T>> (additional);
-	Linear::Matrix <T> result {};
+	if (&additional == this) {
+		Matrix <T> copy { additional };
+		AppendRows (copy, inFront);
+		return;
+	}
+	//	Rows follow each other: new rows go after the existing ones, into spare capacity if there is some.
+	//	Both matrices have the same row length, so the same padding.
+	int oldSize = nRows_ * ld_, addedSize = additional.nRows_ * ld_;
+	Grow (oldSize + addedSize);
 	if (inFront) {
-		additionalVec.insert (additionalVec.end(), mainVec.begin (), mainVec.end ());
-		result = { nRows_ + additional.nRows_, nCols_, additionalVec };
+		for (int i = 0; i < addedSize; ++i) {
+			new (data_ + used_) T {};
+			++used_;
+		}
+		std::move_backward (data_, data_ + oldSize, data_ + oldSize + addedSize);
+		std::copy (additional.data_, additional.data_ + addedSize, data_);
 	}
 	else {
-		mainVec.insert (mainVec.end(), additionalVec.begin (), additionalVec.end ());
-		result = { nRows_ + additional.nRows_, nCols_, mainVec };
+		for (int i = 0; i < addedSize; ++i) {
+			new (data_ + used_) T { additional.data_[i] };
+			++used_;
+		}
 	}
-	*this = result;
+	nRows_ += additional.nRows_;
 }
 
 template <typename T>
@@ -474,7 +919,7 @@ void Linear::Matrix <T>::SwapCols (int lhs, int rhs) {
 	}
 	else {
 		for (int i = 0;  i < nRows_; ++i) {
-			std::swap (At (i, lhs), At (i, rhs));
+			std::swap ((*this) (i, lhs), (*this) (i, rhs));
 		}
 	}
 }
@@ -486,31 +931,67 @@ void Linear::Matrix <T>::AddCols (int source, int destination, T factor) {
 	}
 	else {
 		for (int i = 0; i < nRows_; ++i) {
-			At (i, destination) += At (i, source) * factor;
+			(*this) (i, destination) += (*this) (i, source) * factor;
 		}
 	}
 }
 
 template <typename T>
-void Linear::Matrix <T>::AppendCols (Matrix <T>& additional, bool inFront) {
+void Linear::Matrix <T>::AppendCols (const Matrix <T>& additional, bool inFront) {
 	if (additional.nRows_ != this->nRows_) {
 		throw std::invalid_argument ("Numbers of rows don't match!");
 	}
-    Transpose ();
-    auto mainVec = static_cast <std::vector <T>> (*this);
-	auto additionalVec = static_cast <std::vector <T>> (additional);
-	Transpose ();
-	Linear::Matrix <T> result {};
-	if (inFront) {
-		additionalVec.insert (additionalVec.end(), mainVec.begin (), mainVec.end ());
-		result = { nCols_ + additional.nCols_, nRows_, additionalVec };
+	if (&additional == this) {
+		Matrix <T> copy { additional };
+		AppendCols (copy, inFront);
+		return;
+	}
+	if (additional.nCols_ == 0) {
+		return;
+	}
+	int nCols = nCols_ + additional.nCols_, ld = Stride (nCols), required = nRows_ * ld;
+	int mainOffset = (inFront ? additional.nCols_ : 0), addedOffset = (inFront ? 0 : nCols_);
+	if (required <= size_) {
+		//	Rows only move forward: going from the last one, nothing is overwritten before it is moved
+		while (used_ < required) {
+			new (data_ + used_) T {};
+			++used_;
+		}
+		for (int i = nRows_ - 1; i >= 0; --i) {
+			T* source = data_ + i * ld_;
+			T* destination = data_ + i * ld + mainOffset;
+			if (destination != source) {
+				std::move_backward (source, source + nCols_, destination + nCols_);
+			}
+			std::copy (additional.Row (i), additional.Row (i) + additional.nCols_, data_ + i * ld + addedOffset);
+			std::fill (data_ + i * ld + nCols, data_ + (i + 1) * ld, T {});
+		}
 	}
 	else {
-		mainVec.insert (mainVec.end(), additionalVec.begin (), additionalVec.end ());
-		result = { nCols_ + additional.nCols_, nRows_, mainVec };
+		//	One pass over both matrices into a grown buffer
+		Matrix <T> temp { 0, 0, T {}, resource_ };
+		temp.Grow (std::max (required, size_ * BUFFER_GROWTH_FACTOR));
+		for (int i = 0; i < nRows_; ++i) {
+			for (int j = 0; j < ld; ++j) {
+				if (j >= mainOffset && j < mainOffset + nCols_) {
+					new (temp.data_ + temp.used_) T { std::move ((*this) (i, j - mainOffset)) };
+				}
+				else if (j < nCols) {
+					new (temp.data_ + temp.used_) T { additional (i, j - addedOffset) };
+				}
+				else {
+					new (temp.data_ + temp.used_) T {};
+				}
+				++temp.used_;
+			}
+		}
+		temp.nRows_ = nRows_;
+		temp.nCols_ = nCols;
+		temp.ld_ = ld;
+		*this = std::move (temp);
 	}
-	result.Transpose ();
-	*this = result;
+	nCols_ = nCols;
+	ld_ = ld;
 }
 
 template <typename T>
@@ -524,7 +1005,7 @@ template <typename T>
 Linear::Matrix <T> Linear::Matrix <T>::Eye (int n) {
 	Matrix <T> temp {n};
 	for (int i = 0; i < n; ++i) {
-		temp.At (i, i) = static_cast <T> (1);
+		temp (i, i) = static_cast <T> (1);
 	}
 	//	No std::move here because of RVO
 	return temp;
@@ -540,24 +1021,40 @@ int Linear::Matrix <T>::Size () const {
 	return nRows_ * nCols_;
 }
 
+template <typename T>
+int Linear::Matrix <T>::Capacity () const {
+	return size_;
+}
+
+template <typename T>
+int Linear::Matrix <T>::LeadingDimension () const {
+	return ld_;
+}
+
 template <typename T>
 T Linear::Matrix <T>::Trace () const {
 	T ans {};
 	for (int i = 0; i < std::min <int> (nRows_, nCols_); ++i) {
-		ans += At (i, i);
+		ans += (*this) (i, i);
 	}
 	return ans;
 }
 
 template <typename T>
-const T& Linear::Matrix <T>::At (int i, int j) const {
-	if (i >= nRows_ || j >= nCols_) {
-		std::cerr << "i = " << i << ", j = " << j << std::endl;
-		throw (std::invalid_argument ("Wrong i / j value."));
-	}
-	else {
-		return data_[i * nCols_ + j];
+void Linear::Matrix <T>::CheckBounds (int i, int j) const {
+#ifndef MATRIX_NO_BOUNDS_CHECK
+	if (i < 0 || i >= nRows_ || j < 0 || j >= nCols_) {
+		std::stringstream message {};
+		message << "Wrong i / j value: i = " << i << ", j = " << j << ".";
+		throw (std::invalid_argument (message.str ()));
 	}
+#endif
+}
+
+template <typename T>
+const T& Linear::Matrix <T>::At (int i, int j) const {
+	CheckBounds (i, j);
+	return (*this) (i, j);
 }
 
 template <typename T>
@@ -569,16 +1066,47 @@ void Linear::Matrix <T>::Dump (std::ostream& stream) const {
 	stream.precision (2);
 	for (int i = 0; i < nRows_; ++i) {
 		for (int j = 0; j < nCols_; ++j) {
-			stream << std::left << std::setw (10) << At (i, j);
+			stream << std::left << std::setw (10) << (*this) (i, j);
 		}
 		if (i != nRows_ - 1)
 			stream << std::endl;
 	}
 }
 
+template <typename T>
+const T& Linear::Matrix <T>::operator () (int i, int j) const {
+	return data_[i * ld_ + j];
+}
+
+template <typename T>
+const T* Linear::Matrix <T>::Row (int i) const {
+	return data_ + i * ld_;
+}
+
 template <typename T>
 T& Linear::Matrix <T>::At (int i, int j) {
-	return const_cast <T&> (static_cast <const Matrix<T>*> (this)->At (i, j));
+	CheckBounds (i, j);
+	return (*this) (i, j);
+}
+
+template <typename T>
+T& Linear::Matrix <T>::operator () (int i, int j) {
+	return data_[i * ld_ + j];
+}
+
+template <typename T>
+T* Linear::Matrix <T>::Row (int i) {
+	return data_ + i * ld_;
+}
+
+template <typename T>
+Linear::MatrixView <T> Linear::Matrix <T>::View () & {
+	return { data_, nRows_, nCols_, ld_ };
+}
+
+template <typename T>
+Linear::MatrixView <const T> Linear::Matrix <T>::View () const & {
+	return { data_, nRows_, nCols_, ld_ };
 }
 
 template <typename T>
@@ -592,7 +1120,13 @@ T Linear::Matrix <T>::Determinant (Determinant::Type type) const {
 			return Determinant::Full (*this);
 		}
 		case Determinant::Type::GAUSS: {
-			return Determinant::Gauss (*this);
+			if constexpr (std::is_same <T, double>::value) {
+				return Determinant::Gauss (*this);
+			}
+			throw (std::invalid_argument ("Gauss determinant is for double matrices only."));
+		}
+		case Determinant::Type::BAREISS: {
+			return Determinant::Bareiss (*this);
 		}
 	}
 	return 0;
@@ -600,16 +1134,7 @@ T Linear::Matrix <T>::Determinant (Determinant::Type type) const {
 
 template <typename T>
 int Linear::Matrix <T>::Rank () const {
-	Matrix <T> temp = *this;
-	temp.MakeEye (false);
-	int ans = 0;
-	for (int i = 0; i < std::min <int> (nRows_, nCols_); ++i) {
-		if (std::fabs (At (i, i)) > EPS) {
-			++ans;
-			continue;
-		}
-	}
-	return ans;
+	return FactorizeQR ().Rank ();
 }
 
 template <typename T>
@@ -631,39 +1156,6 @@ std::ostream& Linear::operator << (std::ostream& stream, const Matrix <T>& rhs)
 	return stream;
 }
 
-template <typename T>
-Linear::Matrix <T> Linear::operator + (const Matrix <T>& lhs, const Matrix <T>& rhs) {
-	Matrix <T> temp { lhs };
-	temp += rhs;
-	//	No std::move here because of RVO
-	return temp;
-}
-
-template <typename T>
-Linear::Matrix <T> Linear::operator - (const Matrix <T>& lhs, const Matrix <T>& rhs) {
-	Matrix <T> temp { lhs };
-	temp -= rhs;
-	//	No std::move here because of RVO
-	return temp;
-}
-
-template <typename T>
-Linear::Matrix <T> Linear::operator * (const T number, const Matrix <T>& rhs) {
-	Matrix <T> temp { rhs };
-	temp *= number;
-	//	No std::move here because of RVO
-	return temp;
-}
-
-template <typename T>
-Linear::Matrix <T> Linear::operator * (const Matrix <T>& lhs, const T number) {
-	return number * lhs;
-}
-
-template <typename T>
-Linear::Matrix <T> Linear::operator * (const Matrix <T>& lhs, const Matrix <T>& rhs) {
-	Matrix <T> temp { lhs };
-	temp *= rhs;
-	//	No std::move here because of RVO
-	return temp;
-}
\ No newline at end of file
+//	FACTORIZATIONS
+#include "LU.hpp"
+#include "QR.hpp"
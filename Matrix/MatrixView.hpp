@@ -0,0 +1,238 @@
+#pragma once
+
+//	SYSTEM
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+//	KERNELS
+#include "Gemm.hpp"
+
+//	EXPRESSIONS
+#include "Expression.hpp"
+
+namespace Linear {
+	//	Non-owning window into row-major memory: element (i, j) is data[i * rowStride + j * colStride].
+	//	Blocks, rows, columns and the transpose of a Matrix are views of the same buffer, so
+	//	minors, panels and transposes are not copied. MatrixView <const T> is read-only.
+	//	A view does not keep the Matrix alive and is invalidated when the Matrix is reassigned.
+	template <typename T>
+	class MatrixView final : public Expression::Node <MatrixView <T>> {
+		private:
+			//	DATA
+			T* data_ = nullptr;
+			int nRows_ = 0, nCols_ = 0;
+			int rowStride_ = 0, colStride_ = 1;
+
+			//	AUXILIARY METHODS
+			void CheckBounds (int i, int j) const;
+
+			template <typename U>
+			friend class MatrixView;
+		public:
+			using Value = std::remove_const_t <T>;
+
+			//	CTORS
+			MatrixView () = default;
+			MatrixView (T* data, int rows, int cols, int rowStride, int colStride = 1);
+
+			//	CTOR FROM MUTABLE VIEW
+			template <typename U, typename = std::enable_if_t <std::is_same <const U, T>::value>>
+			MatrixView (const MatrixView <U>& rhs);
+
+			//	SUBVIEWS
+			MatrixView Block 		(int row, int col, int rows, int cols) const;
+			MatrixView RowView 		(int i) const;
+			MatrixView ColView 		(int j) const;
+			MatrixView Transposed 	() const;
+
+			//	GETTERS
+			PairInt Shape 		() const;
+			int 	Size 		() const;
+			int 	RowStride 	() const;
+			int 	ColStride 	() const;
+			T* 		Data 		() const;
+			Value 	Trace 		() const;
+			T& 		At 			(int i, int j) const;
+
+			//	UNCHECKED GETTER FOR INTERNAL ALGORITHMS
+			T& 		operator () (int i, int j) const;
+
+			//	SETTERS, only for mutable views. Not operator =, which rebinds the view.
+			//	As in Matrix, the expression may read (i, j) of the view only to write (i, j).
+			template <typename E>
+			void Assign (const Expression::Node <E>& expression) const;
+			void Fill 	(const Value& value) const;
+	};
+
+	//	C += A * B, or C -= A * B if subtract is set
+	template <typename A, typename B, typename C>
+	void MultiplyAdd (const MatrixView <A>& a, const MatrixView <B>& b, const MatrixView <C>& c, bool subtract = false);
+
+	//	OUTPUT
+	template <typename T>
+	std::ostream& operator << (std::ostream& stream, const MatrixView <T>& rhs);
+}
+
+template <typename T>
+Linear::MatrixView <T>::MatrixView (T* data, int rows, int cols, int rowStride, int colStride):
+	data_ (data),
+	nRows_ (rows),
+	nCols_ (cols),
+	rowStride_ (rowStride),
+	colStride_ (colStride)
+	{
+		if (nRows_ < 0 || nCols_ < 0) {
+			throw std::invalid_argument ("Wrong number of rows / columns in ctor");
+		}
+		else if (nRows_ * nCols_ == 0) {
+			nRows_ = nCols_ = 0;
+		}
+	}
+
+template <typename T>
+template <typename U, typename>
+Linear::MatrixView <T>::MatrixView (const MatrixView <U>& rhs):
+	data_ (rhs.data_),
+	nRows_ (rhs.nRows_),
+	nCols_ (rhs.nCols_),
+	rowStride_ (rhs.rowStride_),
+	colStride_ (rhs.colStride_)
+	{}
+
+template <typename T>
+Linear::MatrixView <T> Linear::MatrixView <T>::Block (int row, int col, int rows, int cols) const {
+	if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > nRows_ || col + cols > nCols_) {
+		throw (std::invalid_argument ("Block is out of the matrix bounds."));
+	}
+	return { data_ + row * rowStride_ + col * colStride_, rows, cols, rowStride_, colStride_ };
+}
+
+template <typename T>
+Linear::MatrixView <T> Linear::MatrixView <T>::RowView (int i) const {
+	return Block (i, 0, 1, nCols_);
+}
+
+template <typename T>
+Linear::MatrixView <T> Linear::MatrixView <T>::ColView (int j) const {
+	return Block (0, j, nRows_, 1);
+}
+
+template <typename T>
+Linear::MatrixView <T> Linear::MatrixView <T>::Transposed () const {
+	return { data_, nCols_, nRows_, colStride_, rowStride_ };
+}
+
+template <typename T>
+Linear::PairInt Linear::MatrixView <T>::Shape () const {
+	return PairInt { nRows_, nCols_ };
+}
+
+template <typename T>
+int Linear::MatrixView <T>::Size () const {
+	return nRows_ * nCols_;
+}
+
+template <typename T>
+int Linear::MatrixView <T>::RowStride () const {
+	return rowStride_;
+}
+
+template <typename T>
+int Linear::MatrixView <T>::ColStride () const {
+	return colStride_;
+}
+
+template <typename T>
+T* Linear::MatrixView <T>::Data () const {
+	return data_;
+}
+
+template <typename T>
+typename Linear::MatrixView <T>::Value Linear::MatrixView <T>::Trace () const {
+	Value ans {};
+	for (int i = 0; i < std::min <int> (nRows_, nCols_); ++i) {
+		ans += (*this) (i, i);
+	}
+	return ans;
+}
+
+template <typename T>
+void Linear::MatrixView <T>::CheckBounds (int i, int j) const {
+#ifndef MATRIX_NO_BOUNDS_CHECK
+	if (i < 0 || i >= nRows_ || j < 0 || j >= nCols_) {
+		std::stringstream message {};
+		message << "Wrong i / j value: i = " << i << ", j = " << j << ".";
+		throw (std::invalid_argument (message.str ()));
+	}
+#endif
+}
+
+template <typename T>
+T& Linear::MatrixView <T>::At (int i, int j) const {
+	CheckBounds (i, j);
+	return (*this) (i, j);
+}
+
+template <typename T>
+T& Linear::MatrixView <T>::operator () (int i, int j) const {
+	return data_[i * rowStride_ + j * colStride_];
+}
+
+template <typename T>
+template <typename E>
+void Linear::MatrixView <T>::Assign (const Expression::Node <E>& expression) const {
+	static_assert (!std::is_const <T>::value, "Assigning to a read-only view.");
+	const E& node = expression.Self ();
+	if (node.Shape () != Shape ()) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	for (int i = 0; i < nRows_; ++i) {
+		for (int j = 0; j < nCols_; ++j) {
+			(*this) (i, j) = node (i, j);
+		}
+	}
+}
+
+template <typename T>
+void Linear::MatrixView <T>::Fill (const Value& value) const {
+	static_assert (!std::is_const <T>::value, "Assigning to a read-only view.");
+	for (int i = 0; i < nRows_; ++i) {
+		for (int j = 0; j < nCols_; ++j) {
+			(*this) (i, j) = value;
+		}
+	}
+}
+
+template <typename A, typename B, typename C>
+void Linear::MultiplyAdd (const MatrixView <A>& a, const MatrixView <B>& b, const MatrixView <C>& c, bool subtract) {
+	static_assert (!std::is_const <C>::value, "Assigning to a read-only view.");
+	static_assert (std::is_same <std::remove_const_t <A>, C>::value && std::is_same <std::remove_const_t <B>, C>::value,
+				   "Matrix element types differ.");
+	if (a.Shape ().second != b.Shape ().first || a.Shape ().first != c.Shape ().first || b.Shape ().second != c.Shape ().second) {
+		throw (std::invalid_argument ("Trying to multiply by a matrix with inappropriate size."));
+	}
+	int m = c.Shape ().first, n = c.Shape ().second, k = a.Shape ().second;
+	if (m == 0 || n == 0 || k == 0) {
+		return;
+	}
+	if (c.ColStride () == 1) {
+		Gemm::Multiply (m, n, k, a.Data (), a.RowStride (), a.ColStride (), b.Data (), b.RowStride (), b.ColStride (),
+						c.Data (), c.RowStride (), subtract);
+	}
+	else {
+		//	GEMM writes whole rows, a strided C goes through a buffer
+		Matrix <C> temp { c };
+		Gemm::Multiply (m, n, k, a.Data (), a.RowStride (), a.ColStride (), b.Data (), b.RowStride (), b.ColStride (),
+						temp.Row (0), temp.LeadingDimension (), subtract);
+		c.Assign (temp.View ());
+	}
+}
+
+template <typename T>
+std::ostream& Linear::operator << (std::ostream& stream, const MatrixView <T>& rhs) {
+	Matrix <typename MatrixView <T>::Value> { rhs }.Dump (stream);
+	return stream;
+}
@@ -0,0 +1,443 @@
+#pragma once
+
+//	SYSTEM
+#include <vector>
+#include <numeric>
+#include <limits>
+#include <type_traits>
+
+//	MATRIX
+#include "Matrix.hpp"
+
+namespace Linear {
+	//	Panel width of the blocked factorization
+	const int QR_BLOCK_SIZE = 32;
+	//	Fewer right-hand sides than this are handled with plain loops:
+	//	a row operation across them would be too short to pay for the call
+	const int QR_ROW_RHS = 8;
+
+	//	A * P = Q * R with Householder reflectors and column pivoting.
+	//	Every step takes the remaining column of the largest norm, so |R (i, i)| does not grow
+	//	along the diagonal, and the rank is the number of diagonal entries above Tolerance (),
+	//	which is relative to |R (0, 0)|: the same for A and for A scaled by any factor.
+	//	Blocked as LAPACK xGEQP3: the reflectors of a panel are accumulated in F, and the
+	//	trailing matrix gets one GEMM update per panel. Column norms are downdated after every
+	//	step and recomputed only when cancellation makes the downdate inaccurate, which ends
+	//	the panel early. Q is kept as blocks of QR_BLOCK_SIZE reflectors, each I - V * T * V^T,
+	//	so applying it reads the reflectors along rows.
+	template <typename T>
+	class QR final {
+		static_assert (std::is_floating_point <T>::value, "QR needs a floating point type.");
+		private:
+			//	DATA
+			//	R on and above the diagonal, reflector t below (t, t), its first entry 1 implied
+			Matrix <T> factors_ {};
+			//	H_t = I - tau_[t] * v_t * v_t^T
+			std::vector <T> tau_ {};
+			//	Column j of A * P is column permutation_[j] of A
+			std::vector <int> permutation_ {};
+			//	T of every block of reflectors: rows [first, first + width), upper triangular
+			Matrix <T> triangular_ {};
+			int rank_ = 0;
+
+			//	AUXILIARY METHODS
+			void Factorize ();
+			//	Factors up to width columns from offset on, returns how many were factored
+			int  FactorizePanel (int offset, int width, std::vector <T>& norms, std::vector <T>& reference);
+			void SwapCols 		(int lhs, int rhs);
+			void FormTriangular (int first, int width);
+			//	I - V * T * V^T (or its transpose) of the block from first on to rhs
+			void ApplyBlock 	(int first, Matrix <T>& rhs, bool transposed) const;
+			//	y += factor * x, a plain loop for rows shorter than QR_ROW_RHS
+			static void ShortAxpy (int n, T factor, const T* x, T* y);
+		public:
+			//	CTORS
+			QR () = default;
+			explicit QR (Matrix <T> matrix);
+
+			//	GETTERS
+			PairInt 					Shape 		() const;
+			int 						Rank 		() const;
+			//	|R (i, i)| at most this counts as zero: max (rows, cols) * epsilon * |R (0, 0)|
+			T 							Tolerance 	() const;
+			const std::vector <int>& 	Permutation () const;
+			const Matrix <T>& 			Factors 	() const;
+			//	rows x min (rows, cols), orthonormal columns
+			Matrix <T> 					Q 			() const;
+			//	min (rows, cols) x cols, columns in the order of A * P
+			Matrix <T> 					R 			() const;
+
+			//	ALGEBRA
+			//	Q^T * rhs, all rows
+			Matrix <T> 	MultiplyQT 	(Matrix <T> rhs) const;
+			//	The first Rank () rows of reduced solved with R, in the column order of A;
+			//	columns past the rank get 0
+			Matrix <T> 	Substitute 	(const Matrix <T>& reduced) const;
+			//	Least squares solution with zeros past the rank, every column of rhs separately
+			Matrix <T> 	Solve 		(const Matrix <T>& rhs) const;
+			//	A column per column past the rank: 1 there, 0 at the others, and A * column = 0
+			Matrix <T> 	NullSpace 	() const;
+	};
+}
+
+template <typename T>
+Linear::QR <T>::QR (Matrix <T> matrix):
+	factors_ (std::move (matrix)),
+	tau_ (std::min (factors_.Shape ().first, factors_.Shape ().second)),
+	permutation_ (factors_.Shape ().second),
+	triangular_ (static_cast <int> (tau_.size ()), QR_BLOCK_SIZE),
+	rank_ (0)
+	{
+		std::iota (permutation_.begin (), permutation_.end (), 0);
+		Factorize ();
+	}
+
+template <typename T>
+void Linear::QR <T>::Factorize () {
+	int nRows = factors_.Shape ().first, nCols = factors_.Shape ().second;
+	int nSteps = std::min (nRows, nCols);
+	std::vector <T> norms (nCols);
+	for (int i = 0; i < nRows; ++i) {
+		const T* row = factors_.Row (i);
+		for (int j = 0; j < nCols; ++j) {
+			norms[j] += row[j] * row[j];
+		}
+	}
+	for (T& norm : norms) {
+		norm = std::sqrt (norm);
+	}
+	std::vector <T> reference = norms;
+	for (int offset = 0; offset < nSteps; ) {
+		offset += FactorizePanel (offset, std::min (QR_BLOCK_SIZE, nSteps - offset), norms, reference);
+	}
+	for (int first = 0; first < nSteps; first += QR_BLOCK_SIZE) {
+		FormTriangular (first, std::min (QR_BLOCK_SIZE, nSteps - first));
+	}
+	T tolerance = Tolerance ();
+	while (rank_ < nSteps && std::fabs (factors_ (rank_, rank_)) > tolerance) {
+		++rank_;
+	}
+}
+
+template <typename T>
+int Linear::QR <T>::FactorizePanel (int offset, int width, std::vector <T>& norms, std::vector <T>& reference) {
+	int nRows = factors_.Shape ().first, nCols = factors_.Shape ().second;
+	const T downdateLimit = std::sqrt (std::numeric_limits <T>::epsilon ());
+	//	Row t of F^T: tau_t * (A - V * F^T)^T * v_t for the columns from offset on, so that the
+	//	columns right of the panel are A - V * F^T once its reflectors are applied
+	Matrix <T> fT { width, nCols - offset };
+	std::vector <T> inner (width);
+	std::vector <int> recompute {};
+	int j = 0;
+	for (; j < width && recompute.empty (); ++j) {
+		int k = offset + j;
+		int pivot = std::max_element (norms.begin () + k, norms.end ()) - norms.begin ();
+		if (pivot != k) {
+			SwapCols (k, pivot);
+			for (int t = 0; t < j; ++t) {
+				std::swap (fT (t, k - offset), fT (t, pivot - offset));
+			}
+			std::swap (permutation_[k], permutation_[pivot]);
+			norms[pivot] = norms[k];
+			reference[pivot] = reference[k];
+		}
+
+		//	Column k gets the reflectors before it in the panel
+		for (int i = k; i < nRows && j > 0; ++i) {
+			T* row = factors_.Row (i);
+			T sum {};
+			for (int t = 0; t < j; ++t) {
+				sum += row[offset + t] * fT (t, k - offset);
+			}
+			row[k] -= sum;
+		}
+
+		//	Reflector taking column k to beta * e_k
+		T alpha = factors_ (k, k), tail {};
+		for (int i = k + 1; i < nRows; ++i) {
+			tail += factors_ (i, k) * factors_ (i, k);
+		}
+		T beta = alpha;
+		tau_[k] = T {};
+		if (tail != T {}) {
+			beta = -std::copysign (std::sqrt (alpha * alpha + tail), alpha);
+			tau_[k] = (beta - alpha) / beta;
+			T scale = static_cast <T> (1) / (alpha - beta);
+			for (int i = k + 1; i < nRows; ++i) {
+				factors_ (i, k) *= scale;
+			}
+		}
+		factors_ (k, k) = static_cast <T> (1);
+
+		//	F^T row j, against the columns right of k as they were before the panel
+		T* fRow = fT.Row (j);
+		std::fill (fRow, fRow + (k + 1 - offset), T {});
+		for (int i = k; i < nRows && k + 1 < nCols; ++i) {
+			Rows::Axpy (nCols - k - 1, tau_[k] * factors_ (i, k), factors_.Row (i) + k + 1, fRow + (k + 1 - offset));
+		}
+		//	and corrected for the reflectors before it: F^T_j -= tau * (V^T * v)^T * F^T
+		std::fill (inner.begin (), inner.end (), T {});
+		for (int i = k; i < nRows && j > 0; ++i) {
+			ShortAxpy (j, factors_ (i, k), factors_.Row (i) + offset, inner.data ());
+		}
+		for (int t = 0; t < j; ++t) {
+			Rows::Axpy (nCols - offset, -tau_[k] * inner[t], fT.Row (t), fRow);
+		}
+
+		//	Row k is final: it gets every reflector of the panel so far
+		T* row = factors_.Row (k);
+		for (int t = 0; t <= j && k + 1 < nCols; ++t) {
+			Rows::Axpy (nCols - k - 1, -row[offset + t], fT.Row (t) + (k + 1 - offset), row + k + 1);
+		}
+
+		//	Norms of the columns right of k without row k
+		for (int c = k + 1; c < nCols && k + 1 < nRows; ++c) {
+			if (norms[c] == T {}) {
+				continue;
+			}
+			T ratio = std::fabs (row[c]) / norms[c];
+			T left = std::max (T {}, (1 + ratio) * (1 - ratio));
+			T relative = norms[c] / reference[c];
+			if (left * relative * relative <= downdateLimit) {
+				recompute.push_back (c);
+			}
+			else {
+				norms[c] *= std::sqrt (left);
+			}
+		}
+		factors_ (k, k) = beta;
+	}
+
+	//	A22 -= V2 * F^T: the rows and columns after the panel
+	int done = offset + j;
+	if (done < nRows && done < nCols) {
+		MatrixView <const T> lower = factors_.View ().Block (done, offset, nRows - done, j);
+		MatrixView <const T> upper = fT.View ().Block (0, done - offset, j, nCols - done);
+		MultiplyAdd (lower, upper, factors_.View ().Block (done, done, nRows - done, nCols - done), true);
+	}
+	for (int c : recompute) {
+		T norm {};
+		for (int i = done; i < nRows; ++i) {
+			norm += factors_ (i, c) * factors_ (i, c);
+		}
+		norms[c] = reference[c] = std::sqrt (norm);
+	}
+	return j;
+}
+
+template <typename T>
+void Linear::QR <T>::SwapCols (int lhs, int rhs) {
+	for (int i = 0; i < factors_.Shape ().first; ++i) {
+		std::swap (factors_ (i, lhs), factors_ (i, rhs));
+	}
+}
+
+template <typename T>
+void Linear::QR <T>::FormTriangular (int first, int width) {
+	//	H_first * ... * H_(first + width - 1) = I - V * T * V^T, built a column at a time:
+	//	T (0 : i, i) = -tau_i * T (0 : i, 0 : i) * V (:, 0 : i)^T * v_i
+	int nRows = factors_.Shape ().first;
+	Matrix <T> gram { width, width };
+	for (int r = first; r < nRows; ++r) {
+		const T* row = factors_.Row (r) + first;
+		int last = std::min (width, r - first + 1);
+		for (int j = 0; j < last; ++j) {
+			T lhs = (j == r - first ? static_cast <T> (1) : row[j]);
+			T* upper = gram.Row (j);
+			for (int i = j + 1; i < last; ++i) {
+				upper[i] += lhs * (i == r - first ? static_cast <T> (1) : row[i]);
+			}
+		}
+	}
+	for (int i = 0; i < width; ++i) {
+		triangular_ (first + i, i) = tau_[first + i];
+		for (int a = 0; a < i; ++a) {
+			T sum {};
+			for (int b = a; b < i; ++b) {
+				sum += triangular_ (first + a, b) * gram (b, i);
+			}
+			triangular_ (first + a, i) = -tau_[first + i] * sum;
+		}
+	}
+}
+
+template <typename T>
+void Linear::QR <T>::ApplyBlock (int first, Matrix <T>& rhs, bool transposed) const {
+	int nRows = factors_.Shape ().first, k = rhs.Shape ().second;
+	int width = std::min <int> (QR_BLOCK_SIZE, tau_.size () - first);
+	//	W = V^T * rhs
+	Matrix <T> projection { width, k };
+	for (int r = first; r < nRows; ++r) {
+		const T* row = factors_.Row (r) + first;
+		int last = std::min (width, r - first + 1);
+		for (int j = 0; j < last; ++j) {
+			ShortAxpy (k, (j == r - first ? static_cast <T> (1) : row[j]), rhs.Row (r), projection.Row (j));
+		}
+	}
+	//	W = T * W or T^T * W, in place: the rows still needed are the ones not yet overwritten
+	if (transposed) {
+		for (int a = width - 1; a >= 0; --a) {
+			Rows::Scale (k, triangular_ (first + a, a), projection.Row (a));
+			for (int b = 0; b < a; ++b) {
+				ShortAxpy (k, triangular_ (first + b, a), projection.Row (b), projection.Row (a));
+			}
+		}
+	}
+	else {
+		for (int a = 0; a < width; ++a) {
+			Rows::Scale (k, triangular_ (first + a, a), projection.Row (a));
+			for (int b = a + 1; b < width; ++b) {
+				ShortAxpy (k, triangular_ (first + a, b), projection.Row (b), projection.Row (a));
+			}
+		}
+	}
+	//	rhs -= V * W
+	for (int r = first; r < nRows; ++r) {
+		const T* row = factors_.Row (r) + first;
+		int last = std::min (width, r - first + 1);
+		for (int j = 0; j < last; ++j) {
+			ShortAxpy (k, -(j == r - first ? static_cast <T> (1) : row[j]), projection.Row (j), rhs.Row (r));
+		}
+	}
+}
+
+template <typename T>
+void Linear::QR <T>::ShortAxpy (int n, T factor, const T* x, T* y) {
+	if (n >= QR_ROW_RHS) {
+		Rows::Axpy (n, factor, x, y);
+		return;
+	}
+	for (int i = 0; i < n; ++i) {
+		y[i] += x[i] * factor;
+	}
+}
+
+template <typename T>
+Linear::PairInt Linear::QR <T>::Shape () const {
+	return factors_.Shape ();
+}
+
+template <typename T>
+int Linear::QR <T>::Rank () const {
+	return rank_;
+}
+
+template <typename T>
+T Linear::QR <T>::Tolerance () const {
+	auto shape = factors_.Shape ();
+	if (shape.first == 0 || shape.second == 0) {
+		return T {};
+	}
+	return std::max (shape.first, shape.second) * std::numeric_limits <T>::epsilon () * std::fabs (factors_ (0, 0));
+}
+
+template <typename T>
+const std::vector <int>& Linear::QR <T>::Permutation () const {
+	return permutation_;
+}
+
+template <typename T>
+const Linear::Matrix <T>& Linear::QR <T>::Factors () const {
+	return factors_;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::QR <T>::Q () const {
+	int nRows = factors_.Shape ().first, nSteps = tau_.size ();
+	Matrix <T> ans { nRows, nSteps };
+	for (int i = 0; i < nSteps; ++i) {
+		ans (i, i) = static_cast <T> (1);
+	}
+	for (int first = (nSteps - 1) / QR_BLOCK_SIZE * QR_BLOCK_SIZE; first >= 0; first -= QR_BLOCK_SIZE) {
+		ApplyBlock (first, ans, false);
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::QR <T>::R () const {
+	int nCols = factors_.Shape ().second, nSteps = tau_.size ();
+	Matrix <T> ans { nSteps, nCols };
+	for (int i = 0; i < nSteps; ++i) {
+		std::copy (factors_.Row (i) + i, factors_.Row (i) + nCols, ans.Row (i) + i);
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::QR <T>::MultiplyQT (Matrix <T> rhs) const {
+	if (rhs.Shape ().first != factors_.Shape ().first) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	for (int first = 0; first < static_cast <int> (tau_.size ()); first += QR_BLOCK_SIZE) {
+		ApplyBlock (first, rhs, true);
+	}
+	return rhs;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::QR <T>::Substitute (const Matrix <T>& reduced) const {
+	int nCols = factors_.Shape ().second, k = reduced.Shape ().second;
+	if (reduced.Shape ().first < rank_) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	//	R11 * Y = the first rank_ rows, in the order of A * P
+	Matrix <T> solved { rank_, k };
+	for (int t = rank_ - 1; t >= 0; --t) {
+		T* current = solved.Row (t);
+		const T* upper = factors_.Row (t);
+		std::copy (reduced.Row (t), reduced.Row (t) + k, current);
+		if (k < QR_ROW_RHS) {
+			for (int c = 0; c < k; ++c) {
+				T sum {};
+				for (int s = t + 1; s < rank_; ++s) {
+					sum += upper[s] * solved (s, c);
+				}
+				current[c] = (current[c] - sum) / upper[t];
+			}
+			continue;
+		}
+		for (int s = t + 1; s < rank_; ++s) {
+			Rows::Axpy (k, -upper[s], solved.Row (s), current);
+		}
+		Rows::Scale (k, static_cast <T> (1) / upper[t], current);
+	}
+	Matrix <T> ans { nCols, k };
+	for (int t = 0; t < rank_; ++t) {
+		std::copy (solved.Row (t), solved.Row (t) + k, ans.Row (permutation_[t]));
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::QR <T>::Solve (const Matrix <T>& rhs) const {
+	return Substitute (MultiplyQT (rhs));
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::QR <T>::NullSpace () const {
+	int nCols = factors_.Shape ().second, nFree = nCols - rank_;
+	if (nFree == 0) {
+		return Matrix <T> {};
+	}
+	Matrix <T> ans { nCols, nFree };
+	if (rank_ > 0) {
+		//	R11 * y = -R12 for the pivot columns
+		Matrix <T> reduced { rank_, nFree };
+		for (int t = 0; t < rank_; ++t) {
+			for (int c = 0; c < nFree; ++c) {
+				reduced (t, c) = -factors_ (t, rank_ + c);
+			}
+		}
+		ans = Substitute (reduced);
+	}
+	for (int c = 0; c < nFree; ++c) {
+		ans (permutation_[rank_ + c], c) = static_cast <T> (1);
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::QR <T> Linear::Matrix <T>::FactorizeQR () const {
+	return QR <T> { *this };
+}
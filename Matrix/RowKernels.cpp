@@ -0,0 +1,379 @@
+#include "RowKernels.hpp"
+
+//	SYSTEM
+#include <immintrin.h>
+
+//	Rows are long and every element is touched once, so these loops are bound by memory
+//	bandwidth: plain multiply + add is used instead of FMA to keep results bit-identical
+//	to the scalar code on every CPU.
+namespace {
+	enum class Isa {
+		SCALAR = 0,
+		AVX2 = 1,
+		AVX512 = 2
+	};
+
+	Isa DetectIsa () {
+		static const Isa isa = [] () {
+			__builtin_cpu_init ();
+			if (__builtin_cpu_supports ("avx512f")) {
+				return Isa::AVX512;
+			}
+			if (__builtin_cpu_supports ("avx2")) {
+				return Isa::AVX2;
+			}
+			return Isa::SCALAR;
+		} ();
+		return isa;
+	}
+
+	//	DOUBLE, AVX2
+	__attribute__ ((target ("avx2")))
+	void AxpyDoubleAvx2 (int n, double factor, const double* x, double* y) {
+		__m256d f = _mm256_set1_pd (factor);
+		int i = 0;
+		for (; i + 4 <= n; i += 4) {
+			_mm256_storeu_pd (y + i, _mm256_add_pd (_mm256_loadu_pd (y + i), _mm256_mul_pd (_mm256_loadu_pd (x + i), f)));
+		}
+		for (; i < n; ++i) {
+			y[i] += x[i] * factor;
+		}
+	}
+
+	__attribute__ ((target ("avx2")))
+	void SwapDoubleAvx2 (int n, double* x, double* y) {
+		int i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m256d vx = _mm256_loadu_pd (x + i), vy = _mm256_loadu_pd (y + i);
+			_mm256_storeu_pd (x + i, vy);
+			_mm256_storeu_pd (y + i, vx);
+		}
+		for (; i < n; ++i) {
+			std::swap (x[i], y[i]);
+		}
+	}
+
+	__attribute__ ((target ("avx2")))
+	void ScaleDoubleAvx2 (int n, double factor, double* x) {
+		__m256d f = _mm256_set1_pd (factor);
+		int i = 0;
+		for (; i + 4 <= n; i += 4) {
+			_mm256_storeu_pd (x + i, _mm256_mul_pd (_mm256_loadu_pd (x + i), f));
+		}
+		for (; i < n; ++i) {
+			x[i] *= factor;
+		}
+	}
+
+	__attribute__ ((target ("avx2")))
+	void DivideDoubleAvx2 (int n, double divisor, double* x) {
+		__m256d d = _mm256_set1_pd (divisor);
+		int i = 0;
+		for (; i + 4 <= n; i += 4) {
+			_mm256_storeu_pd (x + i, _mm256_div_pd (_mm256_loadu_pd (x + i), d));
+		}
+		for (; i < n; ++i) {
+			x[i] /= divisor;
+		}
+	}
+
+	//	DOUBLE, AVX-512: the tail is handled with a masked load / store
+	__attribute__ ((target ("avx512f")))
+	void AxpyDoubleAvx512 (int n, double factor, const double* x, double* y) {
+		__m512d f = _mm512_set1_pd (factor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm512_storeu_pd (y + i, _mm512_add_pd (_mm512_loadu_pd (y + i), _mm512_mul_pd (_mm512_loadu_pd (x + i), f)));
+		}
+		if (i < n) {
+			__mmask8 mask = static_cast <__mmask8> ((1u << (n - i)) - 1);
+			__m512d vy = _mm512_maskz_loadu_pd (mask, y + i), vx = _mm512_maskz_loadu_pd (mask, x + i);
+			_mm512_mask_storeu_pd (y + i, mask, _mm512_add_pd (vy, _mm512_mul_pd (vx, f)));
+		}
+	}
+
+	__attribute__ ((target ("avx512f")))
+	void SwapDoubleAvx512 (int n, double* x, double* y) {
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m512d vx = _mm512_loadu_pd (x + i), vy = _mm512_loadu_pd (y + i);
+			_mm512_storeu_pd (x + i, vy);
+			_mm512_storeu_pd (y + i, vx);
+		}
+		if (i < n) {
+			__mmask8 mask = static_cast <__mmask8> ((1u << (n - i)) - 1);
+			__m512d vx = _mm512_maskz_loadu_pd (mask, x + i), vy = _mm512_maskz_loadu_pd (mask, y + i);
+			_mm512_mask_storeu_pd (x + i, mask, vy);
+			_mm512_mask_storeu_pd (y + i, mask, vx);
+		}
+	}
+
+	__attribute__ ((target ("avx512f")))
+	void ScaleDoubleAvx512 (int n, double factor, double* x) {
+		__m512d f = _mm512_set1_pd (factor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm512_storeu_pd (x + i, _mm512_mul_pd (_mm512_loadu_pd (x + i), f));
+		}
+		if (i < n) {
+			__mmask8 mask = static_cast <__mmask8> ((1u << (n - i)) - 1);
+			_mm512_mask_storeu_pd (x + i, mask, _mm512_mul_pd (_mm512_maskz_loadu_pd (mask, x + i), f));
+		}
+	}
+
+	__attribute__ ((target ("avx512f")))
+	void DivideDoubleAvx512 (int n, double divisor, double* x) {
+		__m512d d = _mm512_set1_pd (divisor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm512_storeu_pd (x + i, _mm512_div_pd (_mm512_loadu_pd (x + i), d));
+		}
+		if (i < n) {
+			__mmask8 mask = static_cast <__mmask8> ((1u << (n - i)) - 1);
+			_mm512_mask_storeu_pd (x + i, mask, _mm512_div_pd (_mm512_maskz_loadu_pd (mask, x + i), d));
+		}
+	}
+
+	//	FLOAT, AVX2
+	__attribute__ ((target ("avx2")))
+	void AxpyFloatAvx2 (int n, float factor, const float* x, float* y) {
+		__m256 f = _mm256_set1_ps (factor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm256_storeu_ps (y + i, _mm256_add_ps (_mm256_loadu_ps (y + i), _mm256_mul_ps (_mm256_loadu_ps (x + i), f)));
+		}
+		for (; i < n; ++i) {
+			y[i] += x[i] * factor;
+		}
+	}
+
+	__attribute__ ((target ("avx2")))
+	void SwapFloatAvx2 (int n, float* x, float* y) {
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m256 vx = _mm256_loadu_ps (x + i), vy = _mm256_loadu_ps (y + i);
+			_mm256_storeu_ps (x + i, vy);
+			_mm256_storeu_ps (y + i, vx);
+		}
+		for (; i < n; ++i) {
+			std::swap (x[i], y[i]);
+		}
+	}
+
+	__attribute__ ((target ("avx2")))
+	void ScaleFloatAvx2 (int n, float factor, float* x) {
+		__m256 f = _mm256_set1_ps (factor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm256_storeu_ps (x + i, _mm256_mul_ps (_mm256_loadu_ps (x + i), f));
+		}
+		for (; i < n; ++i) {
+			x[i] *= factor;
+		}
+	}
+
+	__attribute__ ((target ("avx2")))
+	void DivideFloatAvx2 (int n, float divisor, float* x) {
+		__m256 d = _mm256_set1_ps (divisor);
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+			_mm256_storeu_ps (x + i, _mm256_div_ps (_mm256_loadu_ps (x + i), d));
+		}
+		for (; i < n; ++i) {
+			x[i] /= divisor;
+		}
+	}
+
+	//	FLOAT, AVX-512: the tail is handled with a masked load / store
+	__attribute__ ((target ("avx512f")))
+	void AxpyFloatAvx512 (int n, float factor, const float* x, float* y) {
+		__m512 f = _mm512_set1_ps (factor);
+		int i = 0;
+		for (; i + 16 <= n; i += 16) {
+			_mm512_storeu_ps (y + i, _mm512_add_ps (_mm512_loadu_ps (y + i), _mm512_mul_ps (_mm512_loadu_ps (x + i), f)));
+		}
+		if (i < n) {
+			__mmask16 mask = static_cast <__mmask16> ((1u << (n - i)) - 1);
+			__m512 vy = _mm512_maskz_loadu_ps (mask, y + i), vx = _mm512_maskz_loadu_ps (mask, x + i);
+			_mm512_mask_storeu_ps (y + i, mask, _mm512_add_ps (vy, _mm512_mul_ps (vx, f)));
+		}
+	}
+
+	__attribute__ ((target ("avx512f")))
+	void SwapFloatAvx512 (int n, float* x, float* y) {
+		int i = 0;
+		for (; i + 16 <= n; i += 16) {
+			__m512 vx = _mm512_loadu_ps (x + i), vy = _mm512_loadu_ps (y + i);
+			_mm512_storeu_ps (x + i, vy);
+			_mm512_storeu_ps (y + i, vx);
+		}
+		if (i < n) {
+			__mmask16 mask = static_cast <__mmask16> ((1u << (n - i)) - 1);
+			__m512 vx = _mm512_maskz_loadu_ps (mask, x + i), vy = _mm512_maskz_loadu_ps (mask, y + i);
+			_mm512_mask_storeu_ps (x + i, mask, vy);
+			_mm512_mask_storeu_ps (y + i, mask, vx);
+		}
+	}
+
+	__attribute__ ((target ("avx512f")))
+	void ScaleFloatAvx512 (int n, float factor, float* x) {
+		__m512 f = _mm512_set1_ps (factor);
+		int i = 0;
+		for (; i + 16 <= n; i += 16) {
+			_mm512_storeu_ps (x + i, _mm512_mul_ps (_mm512_loadu_ps (x + i), f));
+		}
+		if (i < n) {
+			__mmask16 mask = static_cast <__mmask16> ((1u << (n - i)) - 1);
+			_mm512_mask_storeu_ps (x + i, mask, _mm512_mul_ps (_mm512_maskz_loadu_ps (mask, x + i), f));
+		}
+	}
+
+	__attribute__ ((target ("avx512f")))
+	void DivideFloatAvx512 (int n, float divisor, float* x) {
+		__m512 d = _mm512_set1_ps (divisor);
+		int i = 0;
+		for (; i + 16 <= n; i += 16) {
+			_mm512_storeu_ps (x + i, _mm512_div_ps (_mm512_loadu_ps (x + i), d));
+		}
+		if (i < n) {
+			__mmask16 mask = static_cast <__mmask16> ((1u << (n - i)) - 1);
+			_mm512_mask_storeu_ps (x + i, mask, _mm512_div_ps (_mm512_maskz_loadu_ps (mask, x + i), d));
+		}
+	}
+}
+
+void Linear::Rows::Axpy (int n, double factor, const double* x, double* y) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			AxpyDoubleAvx512 (n, factor, x, y);
+			break;
+		}
+		case Isa::AVX2: {
+			AxpyDoubleAvx2 (n, factor, x, y);
+			break;
+		}
+		default: {
+			Axpy <double> (n, factor, x, y);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Swap (int n, double* x, double* y) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			SwapDoubleAvx512 (n, x, y);
+			break;
+		}
+		case Isa::AVX2: {
+			SwapDoubleAvx2 (n, x, y);
+			break;
+		}
+		default: {
+			Swap <double> (n, x, y);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Scale (int n, double factor, double* x) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			ScaleDoubleAvx512 (n, factor, x);
+			break;
+		}
+		case Isa::AVX2: {
+			ScaleDoubleAvx2 (n, factor, x);
+			break;
+		}
+		default: {
+			Scale <double> (n, factor, x);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Divide (int n, double divisor, double* x) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			DivideDoubleAvx512 (n, divisor, x);
+			break;
+		}
+		case Isa::AVX2: {
+			DivideDoubleAvx2 (n, divisor, x);
+			break;
+		}
+		default: {
+			Divide <double> (n, divisor, x);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Axpy (int n, float factor, const float* x, float* y) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			AxpyFloatAvx512 (n, factor, x, y);
+			break;
+		}
+		case Isa::AVX2: {
+			AxpyFloatAvx2 (n, factor, x, y);
+			break;
+		}
+		default: {
+			Axpy <float> (n, factor, x, y);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Swap (int n, float* x, float* y) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			SwapFloatAvx512 (n, x, y);
+			break;
+		}
+		case Isa::AVX2: {
+			SwapFloatAvx2 (n, x, y);
+			break;
+		}
+		default: {
+			Swap <float> (n, x, y);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Scale (int n, float factor, float* x) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			ScaleFloatAvx512 (n, factor, x);
+			break;
+		}
+		case Isa::AVX2: {
+			ScaleFloatAvx2 (n, factor, x);
+			break;
+		}
+		default: {
+			Scale <float> (n, factor, x);
+			break;
+		}
+	}
+}
+
+void Linear::Rows::Divide (int n, float divisor, float* x) {
+	switch (DetectIsa ()) {
+		case Isa::AVX512: {
+			DivideFloatAvx512 (n, divisor, x);
+			break;
+		}
+		case Isa::AVX2: {
+			DivideFloatAvx2 (n, divisor, x);
+			break;
+		}
+		default: {
+			Divide <float> (n, divisor, x);
+			break;
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+//	SYSTEM
+#include <algorithm>
+
+namespace Linear {
+	namespace Rows {
+		//	GENERIC REALIZATION
+		//	y += factor * x
+		template <typename T>
+		void Axpy (int n, T factor, const T* x, T* y);
+		//	x <-> y
+		template <typename T>
+		void Swap (int n, T* x, T* y);
+		//	x *= factor
+		template <typename T>
+		void Scale (int n, T factor, T* x);
+		//	x /= divisor, element by element: a reciprocal would round differently
+		template <typename T>
+		void Divide (int n, T divisor, T* x);
+
+		//	VECTORIZED REALIZATION
+		//	AVX-512, AVX2 or scalar code, chosen once at runtime by CPU features (RowKernels.cpp)
+		void Axpy 	(int n, double factor, const double* x, double* y);
+		void Axpy 	(int n, float factor, const float* x, float* y);
+		void Swap 	(int n, double* x, double* y);
+		void Swap 	(int n, float* x, float* y);
+		void Scale 	(int n, double factor, double* x);
+		void Scale 	(int n, float factor, float* x);
+		void Divide (int n, double divisor, double* x);
+		void Divide (int n, float divisor, float* x);
+	}
+}
+
+template <typename T>
+void Linear::Rows::Axpy (int n, T factor, const T* x, T* y) {
+	for (int i = 0; i < n; ++i) {
+		y[i] += x[i] * factor;
+	}
+}
+
+template <typename T>
+void Linear::Rows::Swap (int n, T* x, T* y) {
+	for (int i = 0; i < n; ++i) {
+		std::swap (x[i], y[i]);
+	}
+}
+
+template <typename T>
+void Linear::Rows::Scale (int n, T factor, T* x) {
+	for (int i = 0; i < n; ++i) {
+		x[i] *= factor;
+	}
+}
+
+template <typename T>
+void Linear::Rows::Divide (int n, T divisor, T* x) {
+	for (int i = 0; i < n; ++i) {
+		x[i] /= divisor;
+	}
+}
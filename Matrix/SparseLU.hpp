@@ -0,0 +1,401 @@
+#pragma once
+
+//	SYSTEM
+#include <vector>
+#include <set>
+#include <iterator>
+#include <cmath>
+#include <algorithm>
+
+//	MATRIX
+#include "SparseMatrix.hpp"
+
+namespace Linear {
+	//	Diagonal entry is kept as the pivot while it is at least this part of the largest
+	//	candidate: stays close to the fill-reducing order, still bounds element growth
+	const double SPARSE_LU_PIVOT_TOLERANCE = 0.1;
+	//	Pivot smaller than this part of its column's largest entry means a singular matrix
+	const double SPARSE_LU_SINGULAR_TOLERANCE = 1e-12;
+	//	Minimum degree stops updating the graph when every degree exceeds this part of the vertices left
+	const double MINIMUM_DEGREE_DENSE_PART = 0.5;
+
+	//	Minimum degree order of the symmetric pattern of A + A^T, computed on the explicit
+	//	elimination graph. Ties go to the smaller index, so the order is deterministic.
+	template <typename T>
+	std::vector <int> MinimumDegreeOrder (const SparseMatrix <T>& matrix);
+
+	//	P * A * Q = L * U for square sparse matrices (left-looking, Gilbert-Peierls).
+	//	Analyze chooses the column order Q from the pattern only; Factorize finds row
+	//	pivots and the patterns of L and U numerically; Refactorize reuses all of it
+	//	for a matrix with the same pattern and new values.
+	template <typename T>
+	class SparseLU final {
+		private:
+			//	SYMBOLIC
+			int size_ = 0;
+			//	Column k of A * Q is column colOrder_[k] of A
+			std::vector <int> colOrder_ {};
+
+			//	NUMERIC
+			//	Row i of A is row rowOrder_[i] of P * A
+			std::vector <int> rowOrder_ {};
+			//	L by columns, unit diagonal stored first; U by columns, diagonal stored last.
+			//	Row indices refer to P * A.
+			std::vector <int> lStarts_ {}, lRows_ {};
+			std::vector <T> lValues_ {};
+			std::vector <int> uStarts_ {}, uRows_ {};
+			std::vector <T> uValues_ {};
+
+			//	AUXILIARY METHODS
+			void CheckMatrix 	(const SparseMatrix <T>& matrix) const;
+			int  Reach 			(const SparseMatrix <T>& columns, int col, std::vector <int>& pattern,
+								 std::vector <int>& stack, std::vector <int>& positions, std::vector <int>& marks, int stamp) const;
+		public:
+			//	CTORS
+			SparseLU () = default;
+			explicit SparseLU (const SparseMatrix <T>& matrix);
+
+			//	FACTORIZATION
+			void Analyze 		(const SparseMatrix <T>& matrix);
+			void Factorize 		(const SparseMatrix <T>& matrix);
+			void Refactorize 	(const SparseMatrix <T>& matrix);
+
+			//	GETTERS
+			int 						Size 		() const;
+			int 						NonZeros 	() const;
+			const std::vector <int>& 	ColOrder 	() const;
+
+			//	ALGEBRA
+			std::vector <T> Solve (std::vector <T> rhs) const;
+			Matrix <T> 		Solve (const Matrix <T>& rhs) const;
+	};
+}
+
+template <typename T>
+std::vector <int> Linear::MinimumDegreeOrder (const SparseMatrix <T>& matrix) {
+	int n = matrix.Shape ().first;
+	const auto& rowStarts = matrix.RowStarts ();
+	const auto& cols = matrix.Cols ();
+	std::vector <std::vector <int>> adjacency (n);
+	for (int i = 0; i < n; ++i) {
+		for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+			if (cols[pos] != i) {
+				adjacency[i].push_back (cols[pos]);
+				adjacency[cols[pos]].push_back (i);
+			}
+		}
+	}
+	std::set <std::pair <int, int>> queue {};
+	for (int i = 0; i < n; ++i) {
+		std::sort (adjacency[i].begin (), adjacency[i].end ());
+		adjacency[i].erase (std::unique (adjacency[i].begin (), adjacency[i].end ()), adjacency[i].end ());
+		queue.insert ({ static_cast <int> (adjacency[i].size ()), i });
+	}
+
+	//	Eliminating a vertex turns its neighbours into a clique. Once even the sparsest
+	//	remaining vertex is adjacent to most of the others the rest factorizes as a dense
+	//	block whatever the order, so it is appended by degree without more updates.
+	std::vector <int> ans {}, merged {};
+	ans.reserve (n);
+	while (!queue.empty ()) {
+		int remaining = n - ans.size ();
+		if (queue.begin ()->first > MINIMUM_DEGREE_DENSE_PART * remaining) {
+			for (auto& entry : queue) {
+				ans.push_back (entry.second);
+			}
+			break;
+		}
+		int vertex = queue.begin ()->second;
+		queue.erase (queue.begin ());
+		ans.push_back (vertex);
+		std::vector <int> neighbours = std::move (adjacency[vertex]);
+		for (int neighbour : neighbours) {
+			auto& current = adjacency[neighbour];
+			queue.erase ({ static_cast <int> (current.size ()), neighbour });
+			merged.clear ();
+			std::set_union (current.begin (), current.end (), neighbours.begin (), neighbours.end (), std::back_inserter (merged));
+			merged.erase (std::remove_if (merged.begin (), merged.end (), [&] (int other) {
+				return (other == vertex) || (other == neighbour);
+			}), merged.end ());
+			current.swap (merged);
+			queue.insert ({ static_cast <int> (current.size ()), neighbour });
+		}
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::SparseLU <T>::SparseLU (const SparseMatrix <T>& matrix) {
+	Analyze (matrix);
+	Factorize (matrix);
+}
+
+template <typename T>
+void Linear::SparseLU <T>::CheckMatrix (const SparseMatrix <T>& matrix) const {
+	if (matrix.Shape ().first != matrix.Shape ().second) {
+		throw (std::invalid_argument ("Matrix is not square."));
+	}
+	if (!matrix.IsCompressed ()) {
+		throw (std::logic_error ("Sparse matrix has entries that are not compressed yet."));
+	}
+}
+
+template <typename T>
+int Linear::SparseLU <T>::Reach (const SparseMatrix <T>& columns, int col, std::vector <int>& pattern,
+								 std::vector <int>& stack, std::vector <int>& positions, std::vector <int>& marks, int stamp) const {
+	//	Rows of L \ A(:, col) that can be nonzero, in topological order from the returned
+	//	index to the end of pattern. Depth-first search over the columns of L found so far.
+	int top = size_;
+	const auto& starts = columns.RowStarts ();
+	const auto& rows = columns.Cols ();
+	for (int pos = starts[col]; pos < starts[col + 1]; ++pos) {
+		if (marks[rows[pos]] == stamp) {
+			continue;
+		}
+		int head = 0;
+		stack[0] = rows[pos];
+		while (head >= 0) {
+			int row = stack[head], pivot = rowOrder_[row];
+			if (marks[row] != stamp) {
+				marks[row] = stamp;
+				positions[head] = (pivot < 0 ? 0 : lStarts_[pivot]);
+			}
+			int end = (pivot < 0 ? 0 : lStarts_[pivot + 1]);
+			bool done = true;
+			for (int p = positions[head]; p < end; ++p) {
+				if (marks[lRows_[p]] != stamp) {
+					positions[head] = p;
+					stack[++head] = lRows_[p];
+					done = false;
+					break;
+				}
+			}
+			if (done) {
+				--head;
+				pattern[--top] = row;
+			}
+		}
+	}
+	return top;
+}
+
+template <typename T>
+void Linear::SparseLU <T>::Analyze (const SparseMatrix <T>& matrix) {
+	CheckMatrix (matrix);
+	size_ = matrix.Shape ().first;
+	colOrder_ = MinimumDegreeOrder (matrix);
+	rowOrder_.clear ();
+}
+
+template <typename T>
+void Linear::SparseLU <T>::Factorize (const SparseMatrix <T>& matrix) {
+	CheckMatrix (matrix);
+	if (matrix.Shape ().first != size_ || static_cast <int> (colOrder_.size ()) != size_) {
+		throw (std::logic_error ("Matrix was not analyzed."));
+	}
+	int n = size_;
+	SparseMatrix <T> columns = matrix;
+	columns.Transpose ();
+	const auto& starts = columns.RowStarts ();
+	const auto& rows = columns.Cols ();
+	const auto& values = columns.Values ();
+
+	rowOrder_.assign (n, -1);
+	lStarts_.assign (1, 0);
+	uStarts_.assign (1, 0);
+	lRows_.clear ();
+	lValues_.clear ();
+	uRows_.clear ();
+	uValues_.clear ();
+
+	std::vector <T> x (n);
+	std::vector <int> pattern (n), stack (n), positions (n), marks (n, -1);
+	for (int k = 0; k < n; ++k) {
+		int col = colOrder_[k];
+
+		//	x = L \ A(:, col), rows without a pivot yet are just copied
+		int top = Reach (columns, col, pattern, stack, positions, marks, k);
+		double colMax = 0.0;
+		for (int pos = starts[col]; pos < starts[col + 1]; ++pos) {
+			x[rows[pos]] = values[pos];
+			colMax = std::max <double> (colMax, std::fabs (values[pos]));
+		}
+		for (int p = top; p < n; ++p) {
+			int row = pattern[p], pivot = rowOrder_[row];
+			if (pivot < 0) {
+				continue;
+			}
+			for (int q = lStarts_[pivot] + 1; q < lStarts_[pivot + 1]; ++q) {
+				x[lRows_[q]] -= lValues_[q] * x[row];
+			}
+		}
+
+		//	Row of U and choice of the pivot
+		int pivotRow = -1;
+		double pivotMax = -1.0;
+		for (int p = top; p < n; ++p) {
+			int row = pattern[p];
+			if (rowOrder_[row] < 0) {
+				if (std::fabs (x[row]) > pivotMax) {
+					pivotMax = std::fabs (x[row]);
+					pivotRow = row;
+				}
+			}
+			else {
+				uRows_.push_back (rowOrder_[row]);
+				uValues_.push_back (x[row]);
+			}
+		}
+		if (pivotRow == -1 || pivotMax <= SPARSE_LU_SINGULAR_TOLERANCE * colMax || pivotMax == 0.0) {
+			throw (std::runtime_error ("Matrix is singular."));
+		}
+		if (rowOrder_[col] < 0 && marks[col] == k && std::fabs (x[col]) >= SPARSE_LU_PIVOT_TOLERANCE * pivotMax) {
+			pivotRow = col;
+		}
+		T pivot = x[pivotRow];
+		uRows_.push_back (k);
+		uValues_.push_back (pivot);
+		uStarts_.push_back (uRows_.size ());
+		rowOrder_[pivotRow] = k;
+
+		//	Column of L
+		lRows_.push_back (pivotRow);
+		lValues_.push_back (static_cast <T> (1));
+		for (int p = top; p < n; ++p) {
+			int row = pattern[p];
+			if (rowOrder_[row] < 0) {
+				lRows_.push_back (row);
+				lValues_.push_back (x[row] / pivot);
+			}
+			x[row] = T {};
+		}
+		lStarts_.push_back (lRows_.size ());
+	}
+	for (int& row : lRows_) {
+		row = rowOrder_[row];
+	}
+}
+
+template <typename T>
+void Linear::SparseLU <T>::Refactorize (const SparseMatrix <T>& matrix) {
+	//	Same pivots and patterns, new values: no search and no allocation in L and U.
+	//	Throws if the pattern grew or a kept pivot became too small, Factorize then starts over.
+	CheckMatrix (matrix);
+	if (matrix.Shape ().first != size_ || static_cast <int> (rowOrder_.size ()) != size_) {
+		throw (std::logic_error ("Matrix was not factorized."));
+	}
+	int n = size_;
+	SparseMatrix <T> columns = matrix;
+	columns.Transpose ();
+	const auto& starts = columns.RowStarts ();
+	const auto& rows = columns.Cols ();
+	const auto& values = columns.Values ();
+
+	std::vector <T> x (n);
+	std::vector <int> marks (n, -1);
+	for (int k = 0; k < n; ++k) {
+		int col = colOrder_[k];
+		for (int p = uStarts_[k]; p < uStarts_[k + 1]; ++p) {
+			marks[uRows_[p]] = k;
+		}
+		for (int p = lStarts_[k]; p < lStarts_[k + 1]; ++p) {
+			marks[lRows_[p]] = k;
+		}
+		double colMax = 0.0;
+		for (int pos = starts[col]; pos < starts[col + 1]; ++pos) {
+			int row = rowOrder_[rows[pos]];
+			if (marks[row] != k) {
+				throw (std::logic_error ("Matrix pattern differs from the factorized one."));
+			}
+			x[row] = values[pos];
+			colMax = std::max <double> (colMax, std::fabs (values[pos]));
+		}
+		for (int p = uStarts_[k]; p < uStarts_[k + 1] - 1; ++p) {
+			int row = uRows_[p];
+			uValues_[p] = x[row];
+			for (int q = lStarts_[row] + 1; q < lStarts_[row + 1]; ++q) {
+				x[lRows_[q]] -= lValues_[q] * uValues_[p];
+			}
+			x[row] = T {};
+		}
+		T pivot = x[k];
+		x[k] = T {};
+		if (std::fabs (pivot) <= SPARSE_LU_SINGULAR_TOLERANCE * colMax || pivot == T {}) {
+			throw (std::runtime_error ("Pivot vanished, matrix needs a new factorization."));
+		}
+		uValues_[uStarts_[k + 1] - 1] = pivot;
+		for (int q = lStarts_[k] + 1; q < lStarts_[k + 1]; ++q) {
+			lValues_[q] = x[lRows_[q]] / pivot;
+			x[lRows_[q]] = T {};
+		}
+	}
+}
+
+template <typename T>
+int Linear::SparseLU <T>::Size () const {
+	return size_;
+}
+
+template <typename T>
+int Linear::SparseLU <T>::NonZeros () const {
+	return lRows_.size () + uRows_.size ();
+}
+
+template <typename T>
+const std::vector <int>& Linear::SparseLU <T>::ColOrder () const {
+	return colOrder_;
+}
+
+template <typename T>
+std::vector <T> Linear::SparseLU <T>::Solve (std::vector <T> rhs) const {
+	int n = size_;
+	if (static_cast <int> (rowOrder_.size ()) != n) {
+		throw (std::logic_error ("Matrix was not factorized."));
+	}
+	if (static_cast <int> (rhs.size ()) != n) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	std::vector <T> y (n);
+	for (int i = 0; i < n; ++i) {
+		y[rowOrder_[i]] = rhs[i];
+	}
+	//	L * z = P * b
+	for (int j = 0; j < n; ++j) {
+		for (int p = lStarts_[j] + 1; p < lStarts_[j + 1]; ++p) {
+			y[lRows_[p]] -= lValues_[p] * y[j];
+		}
+	}
+	//	U * w = z
+	for (int j = n - 1; j >= 0; --j) {
+		y[j] /= uValues_[uStarts_[j + 1] - 1];
+		for (int p = uStarts_[j]; p < uStarts_[j + 1] - 1; ++p) {
+			y[uRows_[p]] -= uValues_[p] * y[j];
+		}
+	}
+	//	x = Q * w
+	for (int k = 0; k < n; ++k) {
+		rhs[colOrder_[k]] = y[k];
+	}
+	return rhs;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::SparseLU <T>::Solve (const Matrix <T>& rhs) const {
+	//	Every column of rhs is a separate right-hand side
+	int n = size_, k = rhs.Shape ().second;
+	if (rhs.Shape ().first != n) {
+		throw (std::invalid_argument ("Matrix sizes do not match."));
+	}
+	Matrix <T> ans { n, k };
+	std::vector <T> column (n);
+	for (int j = 0; j < k; ++j) {
+		for (int i = 0; i < n; ++i) {
+			column[i] = rhs (i, j);
+		}
+		column = Solve (std::move (column));
+		for (int i = 0; i < n; ++i) {
+			ans (i, j) = column[i];
+		}
+	}
+	return ans;
+}
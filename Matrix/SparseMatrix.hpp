@@ -0,0 +1,385 @@
+#pragma once
+
+//	SYSTEM
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <type_traits>
+
+//	MATRIX
+#include "Matrix.hpp"
+
+namespace Linear {
+	//	Duplicates::SUM needs operator +=, types without it (RV) may only use LAST
+	template <typename T, typename = void>
+	struct HasPlusAssign : std::false_type {};
+	template <typename T>
+	struct HasPlusAssign <T, std::void_t <decltype (std::declval <T&> () += std::declval <const T&> ())>> : std::true_type {};
+
+	//	Entries are assembled as (row, col, value) triplets and merged into compressed
+	//	sparse row storage by Compress (); everything else reads the CSR part only.
+	//	An entry that is not stored equals T {}.
+	template <typename T>
+	class SparseMatrix final {
+		public:
+			//	WHAT COMPRESS DOES WITH REPEATED (row, col)
+			enum class Duplicates {
+				SUM = 0,	//	stamping, as in nodal analysis
+				LAST = 1	//	assignment, as in Matrix::At (i, j) = value
+			};
+		private:
+			//	DATA
+			int nRows_ = 0, nCols_ = 0;
+
+			//	CSR: row i occupies [rowStarts_[i], rowStarts_[i + 1]) of cols_ and values_
+			std::vector <int> rowStarts_ {};
+			std::vector <int> cols_ {};
+			std::vector <T> values_ {};
+
+			//	PENDING TRIPLETS
+			std::vector <int> pendingRows_ {};
+			std::vector <int> pendingCols_ {};
+			std::vector <T> pendingValues_ {};
+
+			//	AUXILIARY METHODS
+			void CheckBounds 	(int i, int j) const;
+			void CheckCompressed () const;
+
+			template <typename U>
+			friend Matrix <U> operator * (const SparseMatrix <U>& lhs, const Matrix <U>& rhs);
+		public:
+			//	CTORS
+			SparseMatrix (int rows = 0, int cols = 0);
+			explicit SparseMatrix (const Matrix <T>& dense);
+
+			//	ASSEMBLY
+			T& 		Insert 		(int i, int j);
+			void 	Add 		(int i, int j, T value);
+			void 	Compress 	(Duplicates policy = Duplicates::SUM);
+			void 	Resize 		(PairInt shape);
+			void 	AppendRows 	(const SparseMatrix <T>& additional);
+
+			//	GETTERS
+			PairInt 	Shape 		() const;
+			int 		NonZeros 	() const;
+			double 		Density 	() const;
+			bool 		IsCompressed () const;
+			T 			At 			(int i, int j) const;
+
+			//	RAW CSR ACCESS
+			const std::vector <int>& 	RowStarts 	() const;
+			const std::vector <int>& 	Cols 		() const;
+			const std::vector <T>& 		Values 		() const;
+			std::vector <T>& 			Values 		();
+
+			//	ALGEBRA
+			void 		Multiply 	(const T* x, T* y) const;
+			void 		Transpose 	() &;
+			Matrix <T> 	ToDense 	() const;
+	};
+
+	//	OVERLOADED OPERATORS
+	template <typename T>
+	Matrix <T> operator * (const SparseMatrix <T>& lhs, const Matrix <T>& rhs);
+	template <typename T>
+	std::vector <T> operator * (const SparseMatrix <T>& lhs, const std::vector <T>& rhs);
+}
+
+template <typename T>
+Linear::SparseMatrix <T>::SparseMatrix (int rows, int cols):
+	nRows_ (rows),
+	nCols_ (cols),
+	rowStarts_ (std::max (rows, 0) + 1, 0)
+	{
+		if (nRows_ < 0 || nCols_ < 0) {
+			throw std::invalid_argument ("Wrong number of rows / columns in ctor");
+		}
+	}
+
+template <typename T>
+Linear::SparseMatrix <T>::SparseMatrix (const Matrix <T>& dense):
+	SparseMatrix (dense.Shape ().first, dense.Shape ().second)
+	{
+		for (int i = 0; i < nRows_; ++i) {
+			const T* row = dense.Row (i);
+			for (int j = 0; j < nCols_; ++j) {
+				if (row[j] != T {}) {
+					cols_.push_back (j);
+					values_.push_back (row[j]);
+				}
+			}
+			rowStarts_[i + 1] = cols_.size ();
+		}
+	}
+
+template <typename T>
+void Linear::SparseMatrix <T>::CheckBounds (int i, int j) const {
+	if (i < 0 || i >= nRows_ || j < 0 || j >= nCols_) {
+		std::stringstream message {};
+		message << "Wrong i / j value: i = " << i << ", j = " << j << ".";
+		throw (std::invalid_argument (message.str ()));
+	}
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::CheckCompressed () const {
+	if (!IsCompressed ()) {
+		throw (std::logic_error ("Sparse matrix has entries that are not compressed yet."));
+	}
+}
+
+template <typename T>
+T& Linear::SparseMatrix <T>::Insert (int i, int j) {
+	//	The reference is valid until the next Insert / Add
+	CheckBounds (i, j);
+	pendingRows_.push_back (i);
+	pendingCols_.push_back (j);
+	pendingValues_.push_back (T {});
+	return pendingValues_.back ();
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::Add (int i, int j, T value) {
+	Insert (i, j) = value;
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::Compress (Duplicates policy) {
+	if (IsCompressed ()) {
+		return;
+	}
+	//	Stored entries first, then pending ones in insertion order
+	int nStored = cols_.size (), nTotal = nStored + pendingCols_.size ();
+	std::vector <int> rows (nTotal), cols (nTotal);
+	std::vector <T> values {};
+	values.reserve (nTotal);
+	for (int i = 0; i < nRows_; ++i) {
+		for (int pos = rowStarts_[i]; pos < rowStarts_[i + 1]; ++pos) {
+			rows[pos] = i;
+		}
+	}
+	std::copy (cols_.begin (), cols_.end (), cols.begin ());
+	std::copy (pendingRows_.begin (), pendingRows_.end (), rows.begin () + nStored);
+	std::copy (pendingCols_.begin (), pendingCols_.end (), cols.begin () + nStored);
+	for (auto& value : values_) {
+		values.push_back (std::move (value));
+	}
+	for (auto& value : pendingValues_) {
+		values.push_back (std::move (value));
+	}
+
+	std::vector <int> order (nTotal);
+	std::iota (order.begin (), order.end (), 0);
+	std::stable_sort (order.begin (), order.end (), [&] (int lhs, int rhs) {
+		return (rows[lhs] != rows[rhs] ? rows[lhs] < rows[rhs] : cols[lhs] < cols[rhs]);
+	});
+
+	cols_.clear ();
+	values_.clear ();
+	std::fill (rowStarts_.begin (), rowStarts_.end (), 0);
+	for (int pos = 0; pos < nTotal; ++pos) {
+		int idx = order[pos];
+		bool repeated = (pos > 0) && (rows[order[pos - 1]] == rows[idx]) && (cols[order[pos - 1]] == cols[idx]);
+		if (!repeated) {
+			cols_.push_back (cols[idx]);
+			values_.push_back (std::move (values[idx]));
+			++rowStarts_[rows[idx] + 1];
+		}
+		else if (policy == Duplicates::SUM) {
+			if constexpr (HasPlusAssign <T>::value) {
+				values_.back () += values[idx];
+			}
+			else {
+				throw (std::invalid_argument ("Duplicates can not be summed for this type."));
+			}
+		}
+		else {
+			values_.back () = std::move (values[idx]);
+		}
+	}
+	std::partial_sum (rowStarts_.begin (), rowStarts_.end (), rowStarts_.begin ());
+
+	pendingRows_.clear ();
+	pendingCols_.clear ();
+	pendingValues_.clear ();
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::Resize (PairInt shape) {
+	//	Growing keeps pending entries; shrinking compresses first and drops what falls outside
+	if (shape.first < 0 || shape.second < 0) {
+		throw std::invalid_argument ("Wrong number of rows / columns in Resize");
+	}
+	if (shape.first < nRows_ || shape.second < nCols_) {
+		Compress (Duplicates::LAST);
+		SparseMatrix <T> ans { shape.first, shape.second };
+		for (int i = 0; i < std::min (nRows_, shape.first); ++i) {
+			for (int pos = rowStarts_[i]; pos < rowStarts_[i + 1]; ++pos) {
+				if (cols_[pos] < shape.second) {
+					ans.cols_.push_back (cols_[pos]);
+					ans.values_.push_back (values_[pos]);
+				}
+			}
+			ans.rowStarts_[i + 1] = ans.cols_.size ();
+		}
+		for (int i = std::min (nRows_, shape.first); i < shape.first; ++i) {
+			ans.rowStarts_[i + 1] = ans.cols_.size ();
+		}
+		*this = std::move (ans);
+	}
+	else {
+		rowStarts_.resize (shape.first + 1, rowStarts_.back ());
+		nRows_ = shape.first;
+		nCols_ = shape.second;
+	}
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::AppendRows (const SparseMatrix <T>& additional) {
+	CheckCompressed ();
+	additional.CheckCompressed ();
+	if (nCols_ != additional.nCols_) {
+		throw (std::invalid_argument ("Trying to append rows with inappropriate size."));
+	}
+	if (this == &additional) {
+		SparseMatrix <T> copy = additional;
+		AppendRows (copy);
+		return;
+	}
+	int offset = cols_.size ();
+	for (int i = 1; i <= additional.nRows_; ++i) {
+		rowStarts_.push_back (offset + additional.rowStarts_[i]);
+	}
+	cols_.insert (cols_.end (), additional.cols_.begin (), additional.cols_.end ());
+	values_.insert (values_.end (), additional.values_.begin (), additional.values_.end ());
+	nRows_ += additional.nRows_;
+}
+
+template <typename T>
+Linear::PairInt Linear::SparseMatrix <T>::Shape () const {
+	return PairInt { nRows_, nCols_ };
+}
+
+template <typename T>
+int Linear::SparseMatrix <T>::NonZeros () const {
+	return cols_.size ();
+}
+
+template <typename T>
+double Linear::SparseMatrix <T>::Density () const {
+	double size = static_cast <double> (nRows_) * nCols_;
+	return (size == 0 ? 0.0 : NonZeros () / size);
+}
+
+template <typename T>
+bool Linear::SparseMatrix <T>::IsCompressed () const {
+	return pendingCols_.empty ();
+}
+
+template <typename T>
+T Linear::SparseMatrix <T>::At (int i, int j) const {
+	CheckBounds (i, j);
+	CheckCompressed ();
+	auto begin = cols_.begin () + rowStarts_[i], end = cols_.begin () + rowStarts_[i + 1];
+	auto found = std::lower_bound (begin, end, j);
+	if (found == end || *found != j) {
+		return T {};
+	}
+	return values_[found - cols_.begin ()];
+}
+
+template <typename T>
+const std::vector <int>& Linear::SparseMatrix <T>::RowStarts () const {
+	return rowStarts_;
+}
+
+template <typename T>
+const std::vector <int>& Linear::SparseMatrix <T>::Cols () const {
+	return cols_;
+}
+
+template <typename T>
+const std::vector <T>& Linear::SparseMatrix <T>::Values () const {
+	return values_;
+}
+
+template <typename T>
+std::vector <T>& Linear::SparseMatrix <T>::Values () {
+	return values_;
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::Multiply (const T* x, T* y) const {
+	//	y = A * x
+	CheckCompressed ();
+	for (int i = 0; i < nRows_; ++i) {
+		T sum {};
+		for (int pos = rowStarts_[i]; pos < rowStarts_[i + 1]; ++pos) {
+			sum += values_[pos] * x[cols_[pos]];
+		}
+		y[i] = sum;
+	}
+}
+
+template <typename T>
+void Linear::SparseMatrix <T>::Transpose () & {
+	//	Counting sort by column keeps the columns of every new row sorted
+	CheckCompressed ();
+	SparseMatrix <T> ans { nCols_, nRows_ };
+	for (int col : cols_) {
+		++ans.rowStarts_[col + 1];
+	}
+	std::partial_sum (ans.rowStarts_.begin (), ans.rowStarts_.end (), ans.rowStarts_.begin ());
+	ans.cols_.resize (cols_.size ());
+	ans.values_.resize (values_.size ());
+	std::vector <int> next (ans.rowStarts_.begin (), ans.rowStarts_.end () - 1);
+	for (int i = 0; i < nRows_; ++i) {
+		for (int pos = rowStarts_[i]; pos < rowStarts_[i + 1]; ++pos) {
+			int dest = next[cols_[pos]]++;
+			ans.cols_[dest] = i;
+			ans.values_[dest] = values_[pos];
+		}
+	}
+	*this = std::move (ans);
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::SparseMatrix <T>::ToDense () const {
+	CheckCompressed ();
+	Matrix <T> ans { nRows_, nCols_ };
+	for (int i = 0; i < nRows_; ++i) {
+		for (int pos = rowStarts_[i]; pos < rowStarts_[i + 1]; ++pos) {
+			ans (i, cols_[pos]) = values_[pos];
+		}
+	}
+	return ans;
+}
+
+template <typename T>
+Linear::Matrix <T> Linear::operator * (const SparseMatrix <T>& lhs, const Matrix <T>& rhs) {
+	if (lhs.Shape ().second != rhs.Shape ().first) {
+		throw (std::invalid_argument ("Trying to multiply by a matrix with inappropriate size."));
+	}
+	lhs.CheckCompressed ();
+	int nRows = lhs.Shape ().first, nCols = rhs.Shape ().second;
+	const auto& rowStarts = lhs.RowStarts ();
+	const auto& cols = lhs.Cols ();
+	const auto& values = lhs.Values ();
+	Matrix <T> ans { nRows, nCols };
+	for (int i = 0; i < nRows; ++i) {
+		for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+			Rows::Axpy (nCols, values[pos], rhs.Row (cols[pos]), ans.Row (i));
+		}
+	}
+	return ans;
+}
+
+template <typename T>
+std::vector <T> Linear::operator * (const SparseMatrix <T>& lhs, const std::vector <T>& rhs) {
+	if (lhs.Shape ().second != static_cast <int> (rhs.size ())) {
+		throw (std::invalid_argument ("Trying to multiply by a vector with inappropriate size."));
+	}
+	std::vector <T> ans (lhs.Shape ().first);
+	lhs.Multiply (rhs.data (), ans.data ());
+	return ans;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+//	SYSTEM
+#include <algorithm>
+#include <utility>
+
+namespace Linear {
+	namespace Transposition {
+		//	BLOCKING PARAMETER
+		//	Two TILE x TILE tiles of doubles fit in L1, below this the recursion stops
+		const int TILE = 32;
+
+		//	REALIZATION
+		//	Rows are ld elements apart in memory
+		//	n x n square at data becomes its transpose in place, cache-oblivious
+		template <typename T>
+		void Square (int n, T* data, int ld);
+		//	upper (rows x cols) <-> transpose of lower (cols x rows)
+		template <typename T>
+		void SwapBlocks (int rows, int cols, T* upper, T* lower, int ld);
+		//	Tile rows [begin, end) of the in-place transpose of an n x n square: every tile
+		//	on or right of the diagonal is swapped with its mirror, so tile rows are
+		//	independent and threads may take different ones
+		template <typename T>
+		void SquareTiles (int n, T* data, int ld, int begin, int end);
+		//	destination (cols x rows) = transpose of source (rows x cols), tile by tile
+		template <typename T>
+		void Copy (int rows, int cols, const T* source, int lds, T* destination, int ldd);
+	}
+}
+
+template <typename T>
+void Linear::Transposition::Square (int n, T* data, int ld) {
+	if (n <= TILE) {
+		for (int i = 0; i < n; ++i) {
+			for (int j = i + 1; j < n; ++j) {
+				std::swap (data[i * ld + j], data[j * ld + i]);
+			}
+		}
+		return;
+	}
+	//	| A B |    | A' C' |
+	//	| C D | -> | B' D' |
+	int half = n / 2;
+	Square (half, data, ld);
+	Square (n - half, data + half * ld + half, ld);
+	SwapBlocks (half, n - half, data + half, data + half * ld, ld);
+}
+
+template <typename T>
+void Linear::Transposition::SwapBlocks (int rows, int cols, T* upper, T* lower, int ld) {
+	if (rows <= TILE && cols <= TILE) {
+		for (int i = 0; i < rows; ++i) {
+			for (int j = 0; j < cols; ++j) {
+				std::swap (upper[i * ld + j], lower[j * ld + i]);
+			}
+		}
+	}
+	else if (rows >= cols) {
+		int half = rows / 2;
+		SwapBlocks (half, cols, upper, lower, ld);
+		SwapBlocks (rows - half, cols, upper + half * ld, lower + half, ld);
+	}
+	else {
+		int half = cols / 2;
+		SwapBlocks (rows, half, upper, lower, ld);
+		SwapBlocks (rows, cols - half, upper + half, lower + half * ld, ld);
+	}
+}
+
+template <typename T>
+void Linear::Transposition::SquareTiles (int n, T* data, int ld, int begin, int end) {
+	for (int tile = begin; tile < end; ++tile) {
+		int iBegin = tile * TILE, iEnd = std::min (iBegin + TILE, n);
+		for (int i = iBegin; i < iEnd; ++i) {
+			for (int j = i + 1; j < iEnd; ++j) {
+				std::swap (data[i * ld + j], data[j * ld + i]);
+			}
+		}
+		for (int jj = iEnd; jj < n; jj += TILE) {
+			SwapBlocks (iEnd - iBegin, std::min (TILE, n - jj), data + iBegin * ld + jj, data + jj * ld + iBegin, ld);
+		}
+	}
+}
+
+template <typename T>
+void Linear::Transposition::Copy (int rows, int cols, const T* source, int lds, T* destination, int ldd) {
+	for (int ii = 0; ii < rows; ii += TILE) {
+		int iEnd = std::min (ii + TILE, rows);
+		for (int jj = 0; jj < cols; jj += TILE) {
+			int jEnd = std::min (jj + TILE, cols);
+			for (int i = ii; i < iEnd; ++i) {
+				for (int j = jj; j < jEnd; ++j) {
+					destination[j * ldd + i] = source[i * lds + j];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,232 @@
+#include "ThreadPool.hpp"
+
+//  SYSTEM
+#include <algorithm>
+#include <exception>
+
+namespace {
+    //  The pool this thread is a worker of and its deque, set once by Work
+    thread_local Parallel::ThreadPool* workerPool = nullptr;
+    thread_local int workerQueue = -1;
+}
+
+Parallel::ThreadPool::ThreadPool (int nThreads) {
+    for (int i = 0; i < nThreads; ++i) {
+        queues_.push_back (std::make_unique <Queue> ());
+    }
+    for (int i = 0; i < nThreads; ++i) {
+        workers_.emplace_back (&ThreadPool::Work, this, i);
+    }
+}
+
+Parallel::ThreadPool::~ThreadPool () {
+    {
+        std::lock_guard <std::mutex> lock { mutex_ };
+        stop_ = true;
+    }
+    condition_.notify_all ();
+    for (auto& worker : workers_) {
+        worker.join ();
+    }
+}
+
+Parallel::ThreadPool& Parallel::ThreadPool::Shared () {
+    //  The calling thread works too, so one core is left for it
+    static ThreadPool pool { THREAD_POOL_SIZE > 0 ? THREAD_POOL_SIZE : std::max <int> (1, std::thread::hardware_concurrency ()) - 1 };
+    return pool;
+}
+
+int Parallel::ThreadPool::Size () const {
+    return workers_.size ();
+}
+
+int Parallel::ThreadPool::OwnQueue () const {
+    return (workerPool == this ? workerQueue : -1);
+}
+
+void Parallel::ThreadPool::Work (int index) {
+    workerPool = this;
+    workerQueue = index;
+    Task task {};
+    while (true) {
+        if (Take (task)) {
+            task ();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock <std::mutex> lock { mutex_ };
+        condition_.wait (lock, [this] () { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+
+void Parallel::ThreadPool::Push (std::vector <Task>& tasks) {
+    int own = OwnQueue (), nQueues = queues_.size ();
+    for (auto& task : tasks) {
+        //  A worker keeps its tasks, to run them itself unless they are stolen
+        Queue& queue = *queues_[own >= 0 ? own : nextQueue_++ % nQueues];
+        std::lock_guard <std::mutex> lock { queue.mutex };
+        queue.tasks.push_back (std::move (task));
+    }
+    {
+        std::lock_guard <std::mutex> lock { mutex_ };
+        queued_ += tasks.size ();
+    }
+    condition_.notify_all ();
+}
+
+bool Parallel::ThreadPool::Take (Task& task) {
+    int own = OwnQueue (), nQueues = queues_.size ();
+    if (own >= 0) {
+        Queue& queue = *queues_[own];
+        std::lock_guard <std::mutex> lock { queue.mutex };
+        if (!queue.tasks.empty ()) {
+            task = std::move (queue.tasks.back ());
+            queue.tasks.pop_back ();
+            --queued_;
+            return true;
+        }
+    }
+    //  Victims in turn from the next deque on, so thieves do not all start at the same one
+    int first = (own >= 0 ? own + 1 : 0);
+    for (int k = 0; k < nQueues && queued_ > 0; ++k) {
+        Queue& queue = *queues_[(first + k) % nQueues];
+        std::lock_guard <std::mutex> lock { queue.mutex };
+        if (!queue.tasks.empty ()) {
+            task = std::move (queue.tasks.front ());
+            queue.tasks.pop_front ();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Parallel::ThreadPool::RunPendingTask () {
+    Task task {};
+    if (!Take (task)) {
+        return false;
+    }
+    task ();
+    return true;
+}
+
+void Parallel::ThreadPool::ParallelFor (int begin, int end, int minChunk, const std::function <void (int, int)>& body) {
+    int total = end - begin;
+    if (total <= 0) {
+        return;
+    }
+    int nChunks = std::min <long long> (static_cast <long long> (Size () + 1) * PARALLEL_CHUNKS_PER_THREAD,
+                                        (total + std::max (minChunk, 1) - 1) / std::max (minChunk, 1));
+    if (Size () == 0 || nChunks <= 1) {
+        body (begin, end);
+        return;
+    }
+
+    //  Completion of the chunks other threads run, the last one wakes the caller
+    int remaining = nChunks - 1;
+    std::mutex doneMutex {};
+    std::condition_variable done {};
+    std::exception_ptr error {};
+    auto runChunk = [&] (int chunk) {
+        int chunkBegin = begin + static_cast <long long> (total) * chunk / nChunks;
+        int chunkEnd = begin + static_cast <long long> (total) * (chunk + 1) / nChunks;
+        try {
+            body (chunkBegin, chunkEnd);
+        }
+        catch (...) {
+            std::lock_guard <std::mutex> lock { doneMutex };
+            if (!error) {
+                error = std::current_exception ();
+            }
+        }
+    };
+
+    std::vector <Task> tasks {};
+    for (int chunk = nChunks - 1; chunk >= 1; --chunk) {
+        tasks.emplace_back ([&, chunk] () {
+            runChunk (chunk);
+            std::lock_guard <std::mutex> lock { doneMutex };
+            if (--remaining == 0) {
+                done.notify_one ();
+            }
+        });
+    }
+    Push (tasks);
+
+    runChunk (0);
+    //  Help with whatever is queued, then sleep: every chunk left is running on another
+    //  thread, and nested calls there help with their own chunks, so nothing deadlocks
+    while (RunPendingTask ()) {}
+    std::unique_lock <std::mutex> lock { doneMutex };
+    done.wait (lock, [&] () { return remaining == 0; });
+    if (error) {
+        std::rethrow_exception (error);
+    }
+}
+
+namespace {
+    Parallel::Policy& CurrentSlot () {
+#ifdef MATRIX_SEQUENTIAL
+        thread_local Parallel::Policy policy = Parallel::Policy::SEQUENTIAL;
+#else
+        thread_local Parallel::Policy policy = Parallel::Policy::PARALLEL;
+#endif
+        return policy;
+    }
+
+    Parallel::ThreadPool*& PoolSlot () {
+        thread_local Parallel::ThreadPool* pool = nullptr;
+        return pool;
+    }
+}
+
+Parallel::Policy Parallel::Current () {
+    return CurrentSlot ();
+}
+
+Parallel::ThreadPool& Parallel::Pool () {
+    if (PoolSlot ()) {
+        return *PoolSlot ();
+    }
+    return (workerPool ? *workerPool : ThreadPool::Shared ());
+}
+
+Parallel::Scope::Scope (Policy policy):
+    previous_ (CurrentSlot ()),
+    previousPool_ (PoolSlot ())
+    {
+        CurrentSlot () = policy;
+    }
+
+Parallel::Scope::Scope (Policy policy, ThreadPool& pool):
+    previous_ (CurrentSlot ()),
+    previousPool_ (PoolSlot ())
+    {
+        CurrentSlot () = policy;
+        PoolSlot () = &pool;
+    }
+
+Parallel::Scope::~Scope () {
+    CurrentSlot () = previous_;
+    PoolSlot () = previousPool_;
+}
+
+bool Parallel::Splits (Policy policy, long long work) {
+    return policy == Policy::PARALLEL && work >= PARALLEL_MIN_WORK && Pool ().Size () > 0;
+}
+
+void Parallel::For (Policy policy, int begin, int end, int minChunk, long long work, const std::function <void (int, int)>& body) {
+    if (end <= begin) {
+        return;
+    }
+    if (!Splits (policy, work)) {
+        body (begin, end);
+        return;
+    }
+    long long perIndex = std::max <long long> (1, work / (end - begin));
+    int workChunk = static_cast <int> (std::min <long long> (end - begin, (PARALLEL_MIN_WORK + perIndex - 1) / perIndex));
+    Pool ().ParallelFor (begin, end, std::max (minChunk, workChunk), body);
+}
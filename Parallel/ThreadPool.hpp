@@ -0,0 +1,109 @@
+#pragma once
+
+//  SYSTEM
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+//  SETTINGS
+#include "../Settings/Settings.hpp"
+
+namespace Parallel {
+    //  Work-stealing pool: every worker has its own deque of tasks. A worker takes its newest
+    //  task and, with its deque empty, steals the oldest one of another worker, so chunks
+    //  that turn out longer than others do not leave the rest of the threads idle. Idle
+    //  workers sleep until a task is queued.
+    class ThreadPool final {
+        private:
+            using Task = std::function <void ()>;
+            struct Queue {
+                std::mutex mutex {};
+                std::deque <Task> tasks {};
+            };
+
+            //  DATA
+            std::vector <std::thread> workers_ {};
+            std::vector <std::unique_ptr <Queue>> queues_ {};
+            //  Tasks in all deques, changed under mutex_ when it grows so no sleeper misses it
+            std::atomic <int> queued_ { 0 };
+            std::atomic <unsigned> nextQueue_ { 0 };
+            std::mutex mutex_ {};
+            std::condition_variable condition_ {};
+            bool stop_ = false;
+
+            //  WORKERS
+            void Work (int index);
+            //  Deque of the worker running this thread, -1 on other threads
+            int OwnQueue () const;
+            //  Queues tasks on the own deque of a worker, spread over all deques otherwise
+            void Push (std::vector <Task>& tasks);
+            //  The newest own task, or the oldest task of another deque
+            bool Take (Task& task);
+            bool RunPendingTask ();
+        public:
+            //  CTOR
+            explicit ThreadPool (int nThreads);
+            ThreadPool (const ThreadPool& rhs) = delete;
+
+            //  DTOR
+            ~ThreadPool ();
+
+            //  OVERLOADED OPERATOR
+            ThreadPool& operator = (const ThreadPool& rhs) = delete;
+
+            //  One pool for the whole process, THREAD_POOL_SIZE workers or one per spare core
+            static ThreadPool& Shared ();
+
+            //  GETTERS
+            int Size () const;
+
+            //  Splits [begin, end) into chunks of at least minChunk indices, up to
+            //  PARALLEL_CHUNKS_PER_THREAD per thread, and runs body (chunkBegin, chunkEnd) on
+            //  them. The calling thread takes part, then sleeps until the chunks other threads
+            //  took are done. The first exception is rethrown.
+            void ParallelFor (int begin, int end, int minChunk, const std::function <void (int, int)>& body);
+    };
+
+    //  How an operation may use threads: SEQUENTIAL keeps it on the calling thread,
+    //  PARALLEL lets a large one split its rows between the threads of Pool ().
+    //  Matrix methods take a policy argument that defaults to Current (), operators use
+    //  Current () itself. Results are the same under both policies.
+    enum class Policy {
+        SEQUENTIAL = 0,
+        PARALLEL = 1
+    };
+
+    //  The policy of the innermost Scope of this thread, outside scopes PARALLEL,
+    //  or SEQUENTIAL when built with -DMATRIX_SEQUENTIAL
+    Policy Current ();
+    //  The pool of the innermost Scope given one; on the workers of a pool that pool,
+    //  the shared pool otherwise
+    ThreadPool& Pool ();
+
+    class Scope final {
+        private:
+            Policy previous_ = Policy::PARALLEL;
+            ThreadPool* previousPool_ = nullptr;
+        public:
+            explicit Scope (Policy policy);
+            //  Operations in the scope run on pool, which must outlive it
+            Scope (Policy policy, ThreadPool& pool);
+            ~Scope ();
+
+            Scope (const Scope& rhs) = delete;
+            Scope& operator = (const Scope& rhs) = delete;
+    };
+
+    //  Whether For splits work element operations between threads under policy
+    bool Splits (Policy policy, long long work);
+
+    //  body (begin, end) on the calling thread, or ParallelFor on Pool () when the
+    //  policy is PARALLEL and the whole range does at least PARALLEL_MIN_WORK element
+    //  operations; each chunk then gets at least minChunk indices and that much work
+    void For (Policy policy, int begin, int end, int minChunk, long long work, const std::function <void (int, int)>& body);
+}
@@ -30,15 +30,15 @@ bool yy::LangDriver::parse () {
     return !failure;
 }
 
-void yy::LangDriver::execute () {
+void yy::LangDriver::execute (Circuit::Mode mode) {
+    //  A repeated edge keeps its last description
+    adjTable_.Compress (Linear::SparseMatrix <RV>::Duplicates::LAST);
     Circuit circuit { adjTable_ };
-    PairMatrix temp = circuit.Execute ();
-    Solver solver { temp.first, temp.second };
-    temp = solver.Execute ();
+    Linear::Matrix <double> currents = circuit.Currents (mode);
     for (auto edge : givenEdges_) {
         bool containsReversedEdge = false;
         int variableIdx = circuit.GetVariableIdx (edge, containsReversedEdge);
-        std::cout << edge.first << " -- " << edge.second << ": " << temp.second.At (variableIdx, 0) * (containsReversedEdge ? -1 : 1) << " A" << std::endl;
+        std::cout << edge.first << " -- " << edge.second << ": " << currents.At (variableIdx, 0) * (containsReversedEdge ? -1 : 1) << " A" << std::endl;
     }
 }
 
@@ -49,7 +49,7 @@ RV& yy::LangDriver::TableAt (int i, int j) {
     if (shape != adjTable_.Shape ()) {
         adjTable_.Resize (shape);
     }
-    return adjTable_.At (i, j);
+    return adjTable_.Insert (i, j);
 }
 
 void yy::LangDriver::PushGivenEdge (Edge edge) {
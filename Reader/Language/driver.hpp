@@ -21,13 +21,13 @@ namespace yy {
             SyntaxCheck* lexer_ {};
 
             //  CIRCUIT STUFF
-            Linear::Matrix <RV> adjTable_ {};
+            Linear::SparseMatrix <RV> adjTable_ {};
             std::vector <Edge> givenEdges_ {};
         public:
             //  METHODS
             parser::token_type yylex (parser::semantic_type* yylval, parser::location_type* location);
             bool parse ();
-            void execute ();
+            void execute (Circuit::Mode mode = Circuit::Mode::LOOP);
 
             //  CIRCUIT METHODS
             RV& TableAt (int i, int j);
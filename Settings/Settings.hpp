@@ -3,6 +3,50 @@
 //  ACCURACY
 const double EPS = 1e-3;
 
+//  ITERATIVE SOLVERS
+//  Stop when ||b - A * x|| <= ITERATIVE_TOLERANCE * ||b||, or after ITERATIVE_MAX_ITERATIONS
+const double ITERATIVE_TOLERANCE = 1e-10;
+const int ITERATIVE_MAX_ITERATIONS = 10000;
+
+//  DETERMINANT
+//  Determinant::Full expands minors up to this size and uses Bareiss above it
+//  for element types with exact division
+const int DETERMINANT_LAPLACE_MAX_SIZE = 8;
+//  Up to this size the expansion keeps a table of all 2^n minors on the first rows,
+//  above it minors are recomputed
+const int DETERMINANT_MASK_MAX_SIZE = 22;
+//  From this size the minors of each size are split between the threads of Parallel::Pool (),
+//  at least DETERMINANT_PARALLEL_MASKS minors per thread
+const int DETERMINANT_PARALLEL_SIZE = 14;
+const int DETERMINANT_PARALLEL_MASKS = 512;
+
+//  THREADS
+//  Workers of the shared pool besides the calling thread, 0 for one per spare core.
+//  Operations with fewer element operations than PARALLEL_MIN_WORK stay on one thread.
+//  A parallel loop is cut into up to PARALLEL_CHUNKS_PER_THREAD chunks per thread, so that
+//  idle threads have chunks to steal when others are slower.
+//  Build with -DMATRIX_SEQUENTIAL to make Parallel::Policy::SEQUENTIAL the default
+const int THREAD_POOL_SIZE = 0;
+const long long PARALLEL_MIN_WORK = 1 << 16;
+const int PARALLEL_CHUNKS_PER_THREAD = 4;
+
+//  BOUNDS CHECKING
+//  Build with -DMATRIX_NO_BOUNDS_CHECK to compile the checks in Matrix::At out
+
+//  STORAGE LAYOUT
+//  Matrix buffers start on MATRIX_ALIGNMENT bytes. Rows of at least MATRIX_PAD_MIN_BYTES
+//  are padded to a multiple of MATRIX_ALIGNMENT, so every row starts aligned. Narrower rows
+//  are not padded (the padding would be a large part of them), so in small matrices only
+//  the first row is sure to be aligned.
+//  Build with -DMATRIX_NO_PADDING to store rows back to back
+const int MATRIX_ALIGNMENT = 64;
+const int MATRIX_PAD_MIN_BYTES = 512;
+
+//  READER
+//  main <circuit> [--loop | --mna | --mna-iterative] prints the currents of a circuit, without
+//  arguments it runs the tests. Build with -DMATRIX_NO_READER to leave the reader out of main
+//  (the tests only, no flex / bison sources needed)
+
 //  INSTREAM, OUTSTREAM
 #define INSTREAM std::cin
 #define OUTSTREAM std::cout
@@ -0,0 +1,261 @@
+#include "Batch.hpp"
+
+//  SYSTEM
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+    //  Blocks repacked together, so rows of the batch are read in runs of a page
+    const int BATCH_REPACK_BLOCKS = 64;
+
+    //  Calls copy (batch row, first system, systems, block row) for every run of systems
+    //  of one block in one row of an interleaved batch of count systems
+    template <typename Copy>
+    void ForRuns (int count, int rowsPerSystem, Copy copy) {
+        for (int first = 0; first < count; first += BATCH_REPACK_BLOCKS * BATCH_LANES) {
+            int last = std::min (count, first + BATCH_REPACK_BLOCKS * BATCH_LANES);
+            for (int r = 0; r < rowsPerSystem; ++r) {
+                for (int begin = first; begin < last; begin += BATCH_LANES) {
+                    copy (r, begin, std::min (BATCH_LANES, last - begin), (begin / BATCH_LANES) * rowsPerSystem + r);
+                }
+            }
+        }
+    }
+
+    //  Interleaved batch, rowsPerSystem rows per system, to blocks of BATCH_LANES systems;
+    //  lanes past the last system are left as they are
+    void ToBlocks (const Linear::Matrix <double>& batch, int rowsPerSystem, Linear::Matrix <double>& blocks) {
+        ForRuns (batch.Shape ().second, rowsPerSystem, [&] (int r, int begin, int width, int blockRow) {
+            std::copy_n (batch.Row (r) + begin, width, blocks.Row (blockRow));
+        });
+    }
+
+    //  And back
+    void FromBlocks (const Linear::Matrix <double>& blocks, int rowsPerSystem, Linear::Matrix <double>& batch) {
+        ForRuns (batch.Shape ().second, rowsPerSystem, [&] (int r, int begin, int width, int blockRow) {
+            std::copy_n (blocks.Row (blockRow), width, batch.Row (r) + begin);
+        });
+    }
+}
+
+BatchSolver::BatchSolver (int size, const Linear::Matrix <double>& batch):
+    size_ (size),
+    count_ (batch.Shape ().second),
+    nBlocks_ ((count_ + BATCH_LANES - 1) / BATCH_LANES)
+    {
+        if (size_ < 0 || (count_ > 0 && batch.Shape ().first != size_ * size_)) {
+            throw std::invalid_argument ("Batch rows do not match the system size");
+        }
+        if (nBlocks_ == 0) {
+            return;
+        }
+        factors_ = Linear::Matrix <double> { nBlocks_ * size_ * size_, BATCH_LANES };
+        pivots_.assign (nBlocks_ * size_ * BATCH_LANES, 0);
+        singular_.assign (nBlocks_ * BATCH_LANES, 0);
+        for (int s = count_; s < nBlocks_ * BATCH_LANES; ++s) {
+            for (int i = 0; i < size_; ++i) {
+                factors_.Row ((nBlocks_ - 1) * size_ * size_ + i * size_ + i)[s % BATCH_LANES] = 1;
+            }
+        }
+        ToBlocks (batch, size_ * size_, factors_);
+        long long work = static_cast <long long> (count_) * size_ * size_ * size_;
+        Parallel::For (Parallel::Current (), 0, nBlocks_, 1, work, [this] (int begin, int end) {
+            for (int block = begin; block < end; ++block) {
+                Factor (block);
+            }
+        });
+    }
+
+void BatchSolver::Factor (int block) {
+    int n = size_, ld = factors_.LeadingDimension ();
+    double* base = factors_.Row (block * n * n);
+    auto at = [base, n, ld] (int i, int j) { return base + (i * n + j) * ld; };
+    int* pivots = pivots_.data () + block * n * BATCH_LANES;
+    //  A pivot of at most size * epsilon * max |A_s| counts as zero, as in QR::Rank, so
+    //  scaling a system does not change whether it is singular
+    double limit[BATCH_LANES] {};
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            const double* element = at (i, j);
+            for (int s = 0; s < BATCH_LANES; ++s) {
+                limit[s] = std::max (limit[s], std::fabs (element[s]));
+            }
+        }
+    }
+    for (int s = 0; s < BATCH_LANES; ++s) {
+        limit[s] *= n * std::numeric_limits <double>::epsilon ();
+    }
+    double best[BATCH_LANES] {};
+    for (int k = 0; k < n; ++k) {
+        //  Largest candidate of every system
+        int* pivot = pivots + k * BATCH_LANES;
+        const double* column = at (k, k);
+        for (int s = 0; s < BATCH_LANES; ++s) {
+            pivot[s] = k;
+            best[s] = std::fabs (column[s]);
+        }
+        for (int i = k + 1; i < n; ++i) {
+            column = at (i, k);
+            for (int s = 0; s < BATCH_LANES; ++s) {
+                if (std::fabs (column[s]) > best[s]) {
+                    best[s] = std::fabs (column[s]);
+                    pivot[s] = i;
+                }
+            }
+        }
+        //  Swaps differ between systems, so they go element by element
+        for (int s = 0; s < BATCH_LANES; ++s) {
+            if (best[s] <= limit[s]) {
+                singular_[block * BATCH_LANES + s] = 1;
+            }
+            if (pivot[s] != k) {
+                for (int j = 0; j < n; ++j) {
+                    std::swap (at (k, j)[s], at (pivot[s], j)[s]);
+                }
+            }
+        }
+        //  Elimination below the pivot, the inner loops run across systems
+        const double* diagonal = at (k, k);
+        double factor[BATCH_LANES] {};
+        for (int i = k + 1; i < n; ++i) {
+            double* stored = at (i, k);
+            for (int s = 0; s < BATCH_LANES; ++s) {
+                factor[s] = stored[s] /= diagonal[s];
+            }
+            for (int j = k + 1; j < n; ++j) {
+                double* row = at (i, j);
+                const double* pivotRow = at (k, j);
+                for (int s = 0; s < BATCH_LANES; ++s) {
+                    row[s] -= factor[s] * pivotRow[s];
+                }
+            }
+        }
+    }
+}
+
+void BatchSolver::Substitute (Linear::Matrix <double>& blocks, int nRhs, int block) const {
+    int n = size_, ld = factors_.LeadingDimension (), ldRhs = blocks.LeadingDimension ();
+    const double* base = factors_.Row (block * n * n);
+    double* rhs = blocks.Row (block * n * nRhs);
+    auto at = [base, n, ld] (int i, int j) { return base + (i * n + j) * ld; };
+    auto known = [rhs, nRhs, ldRhs] (int i, int r) { return rhs + (i * nRhs + r) * ldRhs; };
+    const int* pivots = pivots_.data () + block * n * BATCH_LANES;
+    //  P * B, in the order of the factorization
+    for (int k = 0; k < n; ++k) {
+        const int* pivot = pivots + k * BATCH_LANES;
+        for (int s = 0; s < BATCH_LANES; ++s) {
+            if (pivot[s] != k) {
+                for (int r = 0; r < nRhs; ++r) {
+                    std::swap (known (k, r)[s], known (pivot[s], r)[s]);
+                }
+            }
+        }
+    }
+    //  L * Y = P * B, L has a unit diagonal
+    for (int k = 0; k < n; ++k) {
+        for (int i = k + 1; i < n; ++i) {
+            const double* factor = at (i, k);
+            for (int r = 0; r < nRhs; ++r) {
+                double* row = known (i, r);
+                const double* solved = known (k, r);
+                for (int s = 0; s < BATCH_LANES; ++s) {
+                    row[s] -= factor[s] * solved[s];
+                }
+            }
+        }
+    }
+    //  U * X = Y
+    for (int k = n - 1; k >= 0; --k) {
+        const double* diagonal = at (k, k);
+        for (int r = 0; r < nRhs; ++r) {
+            double* solved = known (k, r);
+            for (int s = 0; s < BATCH_LANES; ++s) {
+                solved[s] /= diagonal[s];
+            }
+            for (int i = 0; i < k; ++i) {
+                const double* factor = at (i, k);
+                double* row = known (i, r);
+                for (int s = 0; s < BATCH_LANES; ++s) {
+                    row[s] -= factor[s] * solved[s];
+                }
+            }
+        }
+    }
+    for (int s = 0; s < BATCH_LANES; ++s) {
+        if (singular_[block * BATCH_LANES + s]) {
+            for (int i = 0; i < n * nRhs; ++i) {
+                rhs[i * ldRhs + s] = std::numeric_limits <double>::quiet_NaN ();
+            }
+        }
+    }
+}
+
+Linear::Matrix <double> BatchSolver::Interleave (const std::vector <Linear::Matrix <double>>& systems) {
+    if (systems.empty ()) {
+        return Linear::Matrix <double> {};
+    }
+    auto shape = systems[0].Shape ();
+    int count = systems.size ();
+    Linear::Matrix <double> batch { shape.first * shape.second, count };
+    for (int s = 0; s < count; ++s) {
+        if (systems[s].Shape () != shape) {
+            throw std::invalid_argument ("Systems of a batch differ in shape");
+        }
+        for (int i = 0; i < shape.first; ++i) {
+            const double* row = systems[s].Row (i);
+            for (int j = 0; j < shape.second; ++j) {
+                batch.Row (i * shape.second + j)[s] = row[j];
+            }
+        }
+    }
+    return batch;
+}
+
+Linear::Matrix <double> BatchSolver::Extract (const Linear::Matrix <double>& batch, int rows, int cols, int system) {
+    if (batch.Shape ().first != rows * cols || system < 0 || system >= batch.Shape ().second) {
+        throw std::invalid_argument ("No such system in the batch");
+    }
+    Linear::Matrix <double> ans { rows, cols };
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            ans.At (i, j) = batch.Row (i * cols + j)[system];
+        }
+    }
+    return ans;
+}
+
+Linear::Matrix <double> BatchSolver::Solve (const Linear::Matrix <double>& rhs, int nRhs) const {
+    if (count_ == 0 && rhs.Size () == 0) {
+        return Linear::Matrix <double> {};
+    }
+    if (nRhs <= 0 || rhs.Shape () != Linear::PairInt { size_ * nRhs, count_ }) {
+        throw std::invalid_argument ("Right-hand sides do not match the batch");
+    }
+    Linear::Matrix <double> blocks { nBlocks_ * size_ * nRhs, BATCH_LANES };
+    ToBlocks (rhs, size_ * nRhs, blocks);
+    long long work = static_cast <long long> (count_) * size_ * size_ * nRhs;
+    Parallel::For (Parallel::Current (), 0, nBlocks_, 1, work, [&] (int begin, int end) {
+        for (int block = begin; block < end; ++block) {
+            Substitute (blocks, nRhs, block);
+        }
+    });
+    Linear::Matrix <double> answer { size_ * nRhs, count_ };
+    FromBlocks (blocks, size_ * nRhs, answer);
+    return answer;
+}
+
+int BatchSolver::Size () const {
+    return size_;
+}
+
+int BatchSolver::Count () const {
+    return count_;
+}
+
+bool BatchSolver::Singular (int system) const {
+    if (system < 0 || system >= count_) {
+        throw std::invalid_argument ("No such system in the batch");
+    }
+    return singular_[system];
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+//  SYSTEM
+#include <vector>
+
+//  MATRIX
+#include "../Matrix/Matrix.hpp"
+
+//  Systems stored and eliminated together: a cache line of doubles, a full vector on AVX-512
+const int BATCH_LANES = 8;
+
+//  Many independent square systems A_s * X_s = B_s of one shape, solved together.
+//  A batch is interleaved: a Matrix with a row per element position and a column per
+//  system, so A_s (i, j) is batch (i * size + j, s).
+//  Inside, every BATCH_LANES systems are copied to a block of their own, the same element
+//  of all of them in one row of BATCH_LANES. Every elimination step is then one loop across
+//  the systems, which vectorizes, and the block stays in cache for the whole elimination.
+//  Blocks go to different threads under Parallel::Policy::PARALLEL.
+//  Factored once with partial pivoting (LU per system, rows swapped per system),
+//  then solved for any number of right-hand sides.
+class BatchSolver final {
+    private:
+        //  DATA
+        int size_ = 0, count_ = 0, nBlocks_ = 0;
+        //  L below the diagonal and U on and above it: element (i, j) of system
+        //  block * BATCH_LANES + s is factors_ (block * size_ * size_ + i * size_ + j, s).
+        //  Lanes past the last system hold identity matrices.
+        Linear::Matrix <double> factors_ {};
+        //  Row swapped with row k at step k: pivots_[(block * size_ + k) * BATCH_LANES + s]
+        std::vector <int> pivots_ {};
+        //  A pivot of the system was at most size * epsilon * max |A_s|
+        std::vector <char> singular_ {};
+
+        //  Factors one block
+        void Factor (int block);
+        //  Solves one block of right-hand sides in place, laid out like factors_
+        void Substitute (Linear::Matrix <double>& blocks, int nRhs, int block) const;
+    public:
+        //  CTOR, factors the batch
+        BatchSolver (int size, const Linear::Matrix <double>& batch);
+
+        //  INTERLEAVING
+        //  Matrices of one shape to a batch, and system s of a batch back to rows x cols
+        static Linear::Matrix <double> Interleave (const std::vector <Linear::Matrix <double>>& systems);
+        static Linear::Matrix <double> Extract (const Linear::Matrix <double>& batch, int rows, int cols, int system);
+
+        //  SOLVE
+        //  rhs is a batch of size x nRhs matrices, the answer comes back the same way.
+        //  Columns of singular systems are NaN.
+        Linear::Matrix <double> Solve (const Linear::Matrix <double>& rhs, int nRhs = 1) const;
+
+        //  GETTERS
+        int Size () const;
+        int Count () const;
+        bool Singular (int system) const;
+};
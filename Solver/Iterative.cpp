@@ -0,0 +1,263 @@
+#include "Iterative.hpp"
+
+//  SYSTEM
+#include <cmath>
+
+namespace {
+    double Dot (const std::vector <double>& x, const std::vector <double>& y) {
+        double ans = 0.0;
+        for (int i = 0; i < static_cast <int> (x.size ()); ++i) {
+            ans += x[i] * y[i];
+        }
+        return ans;
+    }
+
+    double Norm (const std::vector <double>& x) {
+        return std::sqrt (Dot (x, x));
+    }
+
+    //  r = b - A * x
+    void Residual (const Linear::SparseMatrix <double>& matrix, const std::vector <double>& rhs,
+                   const std::vector <double>& x, std::vector <double>& r) {
+        matrix.Multiply (x.data (), r.data ());
+        for (int i = 0; i < static_cast <int> (r.size ()); ++i) {
+            r[i] = rhs[i] - r[i];
+        }
+    }
+
+    void CheckSystem (const Linear::SparseMatrix <double>& matrix, const std::vector <double>& rhs,
+                      std::vector <double>& guess) {
+        auto shape = matrix.Shape ();
+        if (shape.first != shape.second) {
+            throw (std::invalid_argument ("Matrix is not square."));
+        }
+        if (static_cast <int> (rhs.size ()) != shape.first) {
+            throw (std::invalid_argument ("Matrix sizes do not match."));
+        }
+        if (guess.empty ()) {
+            guess.assign (shape.first, 0.0);
+        }
+        else if (static_cast <int> (guess.size ()) != shape.first) {
+            throw (std::invalid_argument ("Initial guess size does not match."));
+        }
+    }
+}
+
+void Iterative::Identity::Apply (const std::vector <double>& r, std::vector <double>& z) const {
+    z = r;
+}
+
+Iterative::Jacobi::Jacobi (const Linear::SparseMatrix <double>& matrix):
+    inverseDiagonal_ (matrix.Shape ().first, 1.0)
+    {
+        for (int i = 0; i < static_cast <int> (inverseDiagonal_.size ()); ++i) {
+            double diagonal = matrix.At (i, i);
+            if (diagonal != 0.0) {
+                inverseDiagonal_[i] = 1.0 / diagonal;
+            }
+        }
+    }
+
+void Iterative::Jacobi::Apply (const std::vector <double>& r, std::vector <double>& z) const {
+    z.resize (r.size ());
+    for (int i = 0; i < static_cast <int> (r.size ()); ++i) {
+        z[i] = r[i] * inverseDiagonal_[i];
+    }
+}
+
+Iterative::ILU0::ILU0 (const Linear::SparseMatrix <double>& matrix):
+    factors_ (matrix),
+    diagonal_ (matrix.Shape ().first, -1)
+    {
+        //  Gaussian elimination row by row, updates outside the pattern of A are dropped
+        int n = matrix.Shape ().first;
+        const auto& rowStarts = factors_.RowStarts ();
+        const auto& cols = factors_.Cols ();
+        auto& values = factors_.Values ();
+        for (int i = 0; i < n; ++i) {
+            for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+                if (cols[pos] == i) {
+                    diagonal_[i] = pos;
+                }
+            }
+            if (diagonal_[i] == -1 || values[diagonal_[i]] == 0.0) {
+                throw (std::invalid_argument ("ILU(0) needs a nonzero diagonal."));
+            }
+        }
+        std::vector <int> positions (n, -1);
+        for (int i = 0; i < n; ++i) {
+            for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+                positions[cols[pos]] = pos;
+            }
+            for (int pos = rowStarts[i]; pos < rowStarts[i + 1] && cols[pos] < i; ++pos) {
+                int k = cols[pos];
+                values[pos] /= values[diagonal_[k]];
+                for (int other = diagonal_[k] + 1; other < rowStarts[k + 1]; ++other) {
+                    if (positions[cols[other]] != -1) {
+                        values[positions[cols[other]]] -= values[pos] * values[other];
+                    }
+                }
+            }
+            for (int pos = rowStarts[i]; pos < rowStarts[i + 1]; ++pos) {
+                positions[cols[pos]] = -1;
+            }
+            if (values[diagonal_[i]] == 0.0) {
+                throw (std::invalid_argument ("ILU(0) needs a nonzero diagonal."));
+            }
+        }
+    }
+
+void Iterative::ILU0::Apply (const std::vector <double>& r, std::vector <double>& z) const {
+    int n = r.size ();
+    const auto& rowStarts = factors_.RowStarts ();
+    const auto& cols = factors_.Cols ();
+    const auto& values = factors_.Values ();
+    z = r;
+    //  L * y = r
+    for (int i = 0; i < n; ++i) {
+        for (int pos = rowStarts[i]; pos < diagonal_[i]; ++pos) {
+            z[i] -= values[pos] * z[cols[pos]];
+        }
+    }
+    //  U * z = y
+    for (int i = n - 1; i >= 0; --i) {
+        for (int pos = diagonal_[i] + 1; pos < rowStarts[i + 1]; ++pos) {
+            z[i] -= values[pos] * z[cols[pos]];
+        }
+        z[i] /= values[diagonal_[i]];
+    }
+}
+
+Iterative::Result Iterative::CG (const Linear::SparseMatrix <double>& matrix, const std::vector <double>& rhs,
+                                 const Preconditioner& preconditioner, const Options& options, std::vector <double> guess) {
+    CheckSystem (matrix, rhs, guess);
+    int n = rhs.size ();
+    Result ans { std::move (guess), {}, false };
+    double rhsNorm = Norm (rhs);
+    if (rhsNorm == 0.0) {
+        ans.solution.assign (n, 0.0);
+        ans.residuals.push_back (0.0);
+        ans.converged = true;
+        return ans;
+    }
+
+    std::vector <double> r (n), z (n), product (n);
+    Residual (matrix, rhs, ans.solution, r);
+    ans.residuals.push_back (Norm (r) / rhsNorm);
+    preconditioner.Apply (r, z);
+    std::vector <double> direction = z;
+    double rz = Dot (r, z);
+    while (ans.residuals.back () > options.tolerance && ans.Iterations () < options.maxIterations) {
+        matrix.Multiply (direction.data (), product.data ());
+        double curvature = Dot (direction, product);
+        if (curvature <= 0.0) {
+            //  Not positive definite
+            break;
+        }
+        double alpha = rz / curvature;
+        Linear::Rows::Axpy (n, alpha, direction.data (), ans.solution.data ());
+        Linear::Rows::Axpy (n, -alpha, product.data (), r.data ());
+        ans.residuals.push_back (Norm (r) / rhsNorm);
+
+        preconditioner.Apply (r, z);
+        double rzNext = Dot (r, z);
+        Linear::Rows::Scale (n, rzNext / rz, direction.data ());
+        Linear::Rows::Axpy (n, 1.0, z.data (), direction.data ());
+        rz = rzNext;
+    }
+    ans.converged = (ans.residuals.back () <= options.tolerance);
+    return ans;
+}
+
+Iterative::Result Iterative::GMRES (const Linear::SparseMatrix <double>& matrix, const std::vector <double>& rhs,
+                                    const Preconditioner& preconditioner, const Options& options, std::vector <double> guess) {
+    CheckSystem (matrix, rhs, guess);
+    int n = rhs.size (), restart = std::max (1, std::min (options.restart, n));
+    Result ans { std::move (guess), {}, false };
+    double rhsNorm = Norm (rhs);
+    if (rhsNorm == 0.0) {
+        ans.solution.assign (n, 0.0);
+        ans.residuals.push_back (0.0);
+        ans.converged = true;
+        return ans;
+    }
+
+    std::vector <double> r (n), z (n);
+    std::vector <std::vector <double>> basis (restart + 1, std::vector <double> (n));
+    //  Hessenberg matrix, column by column, reduced to upper triangular by Givens rotations
+    std::vector <std::vector <double>> hessenberg (restart, std::vector <double> (restart + 1));
+    std::vector <double> cosines (restart), sines (restart), g (restart + 1), y (restart);
+
+    Residual (matrix, rhs, ans.solution, r);
+    double beta = Norm (r);
+    ans.residuals.push_back (beta / rhsNorm);
+    while (ans.residuals.back () > options.tolerance && ans.Iterations () < options.maxIterations) {
+        for (int i = 0; i < n; ++i) {
+            basis[0][i] = r[i] / beta;
+        }
+        std::fill (g.begin (), g.end (), 0.0);
+        g[0] = beta;
+
+        //  Arnoldi with modified Gram-Schmidt
+        int size = 0;
+        for (int j = 0; j < restart && ans.Iterations () < options.maxIterations; ++j) {
+            auto& h = hessenberg[j];
+            preconditioner.Apply (basis[j], z);
+            matrix.Multiply (z.data (), basis[j + 1].data ());
+            for (int i = 0; i <= j; ++i) {
+                h[i] = Dot (basis[j + 1], basis[i]);
+                Linear::Rows::Axpy (n, -h[i], basis[i].data (), basis[j + 1].data ());
+            }
+            h[j + 1] = Norm (basis[j + 1]);
+            if (h[j + 1] != 0.0) {
+                Linear::Rows::Scale (n, 1.0 / h[j + 1], basis[j + 1].data ());
+            }
+
+            for (int i = 0; i < j; ++i) {
+                double temp = cosines[i] * h[i] + sines[i] * h[i + 1];
+                h[i + 1] = -sines[i] * h[i] + cosines[i] * h[i + 1];
+                h[i] = temp;
+            }
+            double length = std::hypot (h[j], h[j + 1]);
+            cosines[j] = (length == 0.0 ? 1.0 : h[j] / length);
+            sines[j] = (length == 0.0 ? 0.0 : h[j + 1] / length);
+            h[j] = length;
+            h[j + 1] = 0.0;
+            g[j + 1] = -sines[j] * g[j];
+            g[j] = cosines[j] * g[j];
+
+            size = j + 1;
+            ans.residuals.push_back (std::fabs (g[j + 1]) / rhsNorm);
+            if (ans.residuals.back () <= options.tolerance || length == 0.0) {
+                break;
+            }
+        }
+
+        //  x += M^-1 * V * y, H * y = g
+        for (int i = size - 1; i >= 0; --i) {
+            y[i] = g[i];
+            for (int t = i + 1; t < size; ++t) {
+                y[i] -= hessenberg[t][i] * y[t];
+            }
+            y[i] = (hessenberg[i][i] == 0.0 ? 0.0 : y[i] / hessenberg[i][i]);
+        }
+        std::fill (r.begin (), r.end (), 0.0);
+        for (int i = 0; i < size; ++i) {
+            Linear::Rows::Axpy (n, y[i], basis[i].data (), r.data ());
+        }
+        preconditioner.Apply (r, z);
+        Linear::Rows::Axpy (n, 1.0, z.data (), ans.solution.data ());
+
+        //  The rotated estimate drifts, the restart uses the true residual
+        Residual (matrix, rhs, ans.solution, r);
+        double previous = beta;
+        beta = Norm (r);
+        ans.residuals.back () = beta / rhsNorm;
+        if (beta >= previous) {
+            //  Stagnation
+            break;
+        }
+    }
+    ans.converged = (ans.residuals.back () <= options.tolerance);
+    return ans;
+}
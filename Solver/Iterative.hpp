@@ -0,0 +1,72 @@
+#pragma once
+
+//  SYSTEM
+#include <vector>
+
+//  MATRIX
+#include "../Matrix/SparseMatrix.hpp"
+
+//  SETTINGS
+#include "../Settings/Settings.hpp"
+
+namespace Iterative {
+    //  Krylov basis size of GMRES between restarts
+    const int GMRES_RESTART = 50;
+
+    struct Options {
+        double tolerance = ITERATIVE_TOLERANCE;         //  on ||b - A * x|| / ||b||
+        int maxIterations = ITERATIVE_MAX_ITERATIONS;   //  matrix-vector products
+        int restart = GMRES_RESTART;
+    };
+
+    struct Result {
+        std::vector <double> solution {};
+        //  Relative residual norm before the first iteration and after every one
+        std::vector <double> residuals {};
+        bool converged = false;
+
+        int Iterations () const { return residuals.size () - 1; }
+    };
+
+    //  M ~ A, cheap to invert: z = M^-1 * r
+    class Preconditioner {
+        public:
+            virtual ~Preconditioner () = default;
+            virtual void Apply (const std::vector <double>& r, std::vector <double>& z) const = 0;
+    };
+
+    class Identity final : public Preconditioner {
+        public:
+            void Apply (const std::vector <double>& r, std::vector <double>& z) const override;
+    };
+
+    //  Diagonal of A; rows with a zero diagonal (voltage sources in nodal analysis) stay unscaled
+    class Jacobi final : public Preconditioner {
+        private:
+            std::vector <double> inverseDiagonal_ {};
+        public:
+            explicit Jacobi (const Linear::SparseMatrix <double>& matrix);
+            void Apply (const std::vector <double>& r, std::vector <double>& z) const override;
+    };
+
+    //  Incomplete LU without fill: L and U keep the pattern of A, needs a nonzero diagonal
+    class ILU0 final : public Preconditioner {
+        private:
+            //  L below the diagonal (unit diagonal is implied), U on and above it
+            Linear::SparseMatrix <double> factors_ {};
+            std::vector <int> diagonal_ {};
+        public:
+            explicit ILU0 (const Linear::SparseMatrix <double>& matrix);
+            void Apply (const std::vector <double>& r, std::vector <double>& z) const override;
+    };
+
+    //  Preconditioned conjugate gradients, matrix and preconditioner must be symmetric positive definite
+    Result CG (const Linear::SparseMatrix <double>& matrix, const std::vector <double>& rhs,
+               const Preconditioner& preconditioner = Identity {}, const Options& options = {},
+               std::vector <double> guess = {});
+
+    //  Restarted GMRES with right preconditioning, so residuals are those of the original system
+    Result GMRES (const Linear::SparseMatrix <double>& matrix, const std::vector <double>& rhs,
+                  const Preconditioner& preconditioner = Identity {}, const Options& options = {},
+                  std::vector <double> guess = {});
+}
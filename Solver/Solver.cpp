@@ -1,7 +1,31 @@
 #include "Solver.hpp"
 
-int Solver::CheckRank () {
-    int mainRank = main_.Rank (), resultRank = result_.Rank ();
+int Solver::Rank () {
+    Factorize ();
+    return (factorization_ == Factorization::SPARSE ? sparseLU_.Size () : qr_.Rank ());
+}
+
+int Solver::CheckRank (const Linear::Matrix <double>& additional, const Linear::Matrix <double>& reduced, const Linear::Matrix <double>& particular) {
+    //  A column is consistent when what is left past the rank is roundoff of the size
+    //  R and the column itself would leave: the tolerance of the rank, relative to both
+    int mainRank = qr_.Rank (), resultRank = mainRank;
+    auto shape = qr_.Shape ();
+    double relative = std::max (shape.first, shape.second) * std::numeric_limits <double>::epsilon ();
+    for (int c = 0; c < reduced.Shape ().second && resultRank == mainRank; ++c) {
+        double residual = 0.0, answer = 0.0, given = 0.0;
+        for (int i = mainRank; i < reduced.Shape ().first; ++i) {
+            residual = std::max (residual, std::fabs (reduced.At (i, c)));
+        }
+        for (int i = 0; i < particular.Shape ().first; ++i) {
+            answer = std::max (answer, std::fabs (particular.At (i, c)));
+        }
+        for (int i = 0; i < additional.Shape ().first; ++i) {
+            given = std::max (given, std::fabs (additional.At (i, c)));
+        }
+        if (residual > qr_.Tolerance () * answer + relative * given) {
+            resultRank = mainRank + 1;
+        }
+    }
     if (mainRank != resultRank) {
         std::stringstream strstream {};
         strstream << "No solutions: mainRank = " << mainRank << ", resultRank = " << resultRank;
@@ -10,39 +34,104 @@ int Solver::CheckRank () {
     return mainRank;
 }
 
-void Solver::CreateFundamental (int generalRank) {
-    int nRows = result_.Shape ().first, nCols = result_.Shape ().second;
-    std::vector <double> ansFundamentalVec {};
-    for (int i = 0; i < std::min <int> (nRows, nCols - 1); ++i) {
-        for (int j = generalRank; j < nCols - 1; ++j) {
-            ansFundamentalVec.push_back (result_.At (i, j));
+void Solver::CreateFundamental () {
+    //  A solution per column past the rank: 1 there, 0 at the others
+    ansFundamental_ = (factorization_ == Factorization::SPARSE ? Linear::Matrix <double> {} : qr_.NullSpace ());
+}
+
+void Solver::CreateParticular (const Linear::Matrix <double>& additional) {
+    //  Columns past the rank are 0
+    if (factorization_ == Factorization::SPARSE) {
+        ansParticular_ = sparseLU_.Solve (additional);
+        return;
+    }
+    Linear::Matrix <double> reduced = qr_.MultiplyQT (additional);
+    Linear::Matrix <double> particular = qr_.Substitute (reduced);
+    CheckRank (additional, reduced, particular);
+    ansParticular_ = std::move (particular);
+}
+
+bool Solver::TrySparse () {
+    auto shape = (isSparse_ ? sparseMain_.Shape () : main_.Shape ());
+    if (shape.first != shape.second || shape.first < SPARSE_MIN_SIZE) {
+        return false;
+    }
+    if (!isSparse_) {
+        int nonZeros = 0;
+        for (int i = 0; i < shape.first; ++i) {
+            const double* row = main_.Row (i);
+            nonZeros += std::count_if (row, row + shape.second, [] (double value) { return value != 0.0; });
         }
+        if (nonZeros > SPARSE_MAX_DENSITY * shape.first * shape.second) {
+            return false;
+        }
+        sparseMain_ = Linear::SparseMatrix <double> { main_ };
+    }
+    try {
+        sparseLU_ = Linear::SparseLU <double> { sparseMain_ };
     }
-    ansFundamentalVec.resize ((nCols - 1) * ((nCols - 1) - generalRank));
-    ansFundamental_ = { nCols - 1, (nCols - 1) - generalRank, ansFundamentalVec};
-    for (int i = 0; i < (nCols - 1) - generalRank; ++i) {
-        ansFundamental_.At (generalRank + i, i) = -1;
+    catch (std::runtime_error& ex) {
+        //  Singular: the dense path finds the rank and the fundamental solutions
+        return false;
     }
-    ansFundamental_.Negate ();
+    return true;
 }
 
-void Solver::CreateParticular () {
-    int nRows = result_.Shape ().first, nCols = result_.Shape ().second;
-    std::vector <double> ansParticularVec {};
-    for (int i = 0; i < std::min <int> (nRows, nCols - 1); ++i) {
-        ansParticularVec.push_back (result_.At (i, nCols - 1));
+void Solver::Factorize () {
+    if (factorization_ != Factorization::NONE) {
+        return;
+    }
+    if (TrySparse ()) {
+        factorization_ = Factorization::SPARSE;
+    }
+    else {
+        qr_ = Linear::QR <double> { isSparse_ ? sparseMain_.ToDense () : main_ };
+        factorization_ = Factorization::DENSE;
     }
-    ansParticularVec.resize ((nCols - 1) * 1);
-    ansParticular_ = { nCols - 1, 1, ansParticularVec };
+    CreateFundamental ();
+}
+
+PairMatrix Solver::Solve (const Linear::Matrix <double>& additional) {
+    Factorize ();
+    int nRows = (isSparse_ ? sparseMain_.Shape ().first : main_.Shape ().first);
+    if (additional.Shape ().first != nRows) {
+        std::stringstream strstream {};
+        strstream << "Right-hand sides have " << additional.Shape ().first << " rows, the system has " << nRows;
+        throw std::invalid_argument (strstream.str ());
+    }
+    CreateParticular (additional);
+    return { ansFundamental_, ansParticular_ };
 }
 
 PairMatrix Solver::Execute () {
-    result_ = main_;
-    result_.AppendCols (additional_);
-    main_.MakeEye (false);
-    result_.MakeEye (true);
-    int generalRank = CheckRank ();
-    CreateFundamental (generalRank);
-    CreateParticular ();
+    return Solve (additional_);
+}
+
+PairMatrix Solver::ExecuteIterative (const Iterative::Options& options) {
+    if (!isSparse_) {
+        sparseMain_ = Linear::SparseMatrix <double> { main_ };
+    }
+    int n = sparseMain_.Shape ().first;
+    if (additional_.Shape () != Linear::PairInt { n, 1 }) {
+        throw std::invalid_argument ("Iterative solver needs one right-hand side column");
+    }
+    std::vector <double> rhs (n);
+    for (int i = 0; i < n; ++i) {
+        rhs[i] = additional_.At (i, 0);
+    }
+    Iterative::Result result {};
+    try {
+        result = Iterative::GMRES (sparseMain_, rhs, Iterative::ILU0 { sparseMain_ }, options);
+    }
+    catch (std::invalid_argument& ex) {
+        result = Iterative::GMRES (sparseMain_, rhs, Iterative::Jacobi { sparseMain_ }, options);
+    }
+    if (!result.converged) {
+        std::stringstream strstream {};
+        strstream << "GMRES did not converge: residual = " << result.residuals.back () << " after " << result.Iterations () << " iterations";
+        throw std::runtime_error (strstream.str ());
+    }
+    ansFundamental_ = Linear::Matrix <double> {};
+    ansParticular_ = { n, 1, result.solution };
     return { ansFundamental_, ansParticular_ };
-}
\ No newline at end of file
+}
@@ -2,37 +2,97 @@
 
 //  MATRIX
 #include "../Matrix/Matrix.hpp"
+#include "../Matrix/QR.hpp"
+#include "../Matrix/SparseMatrix.hpp"
+#include "../Matrix/SparseLU.hpp"
+
+//  ITERATIVE SOLVERS
+#include "Iterative.hpp"
 
 //  TYPEDEFS
 using PairMatrix = std::pair <Linear::Matrix <double>, Linear::Matrix <double>>;
 
+//  Square systems at least this large with at most this part of nonzero entries
+//  are tried with sparse LU before the dense column-pivoted QR
+const int SPARSE_MIN_SIZE = 64;
+const double SPARSE_MAX_DENSITY = 0.05;
+
+//  main * X = additional, every column of additional a separate right-hand side.
+//  main is factored once, by the first Solve, and every later Solve reuses the factors,
+//  so right-hand sides may come as one block or one after another. Dense systems use QR
+//  with column pivoting, so the rank does not depend on the scale of main. The answer is the
+//  fundamental solutions (a column each, shared by all right-hand sides) and a particular
+//  solution per right-hand side.
 class Solver final {
     private:
+        enum class Factorization {
+            NONE = 0,
+            SPARSE = 1,
+            DENSE = 2
+        };
+
         //  GIVEN
         Linear::Matrix <double> main_ {};
         Linear::Matrix <double> additional_ {};
-        Linear::Matrix <double> result_ {};
+        Linear::SparseMatrix <double> sparseMain_ {};
+        bool isSparse_ = false;
+
+        //  FACTORIZATION
+        Factorization factorization_ = Factorization::NONE;
+        Linear::SparseLU <double> sparseLU_ {};
+        Linear::QR <double> qr_ {};
 
         //  COMPUTATIONS
         Linear::Matrix <double> ansFundamental_ {};
         Linear::Matrix <double> ansParticular_ {};
+
+        //  Regular square sparse system: the only solution, no fundamental part
+        bool TrySparse ();
+        void Factorize ();
     public:
-        //  CTOR
-        Solver (Linear::Matrix <double> main, Linear::Matrix <double> additional):
-            main_ (main),
-            additional_ (additional),
-            result_ ({}),
+        //  CTORS
+        Solver (Linear::Matrix <double> main, Linear::Matrix <double> additional = Linear::Matrix <double> {}):
+            main_ (std::move (main)),
+            additional_ (std::move (additional)),
+            sparseMain_ ({}),
+            isSparse_ (false),
+            factorization_ (Factorization::NONE),
+            sparseLU_ (),
+            qr_ (),
             ansFundamental_ ({}),
             ansParticular_ ({})
             {}
+        Solver (Linear::SparseMatrix <double> main, Linear::Matrix <double> additional = Linear::Matrix <double> {}):
+            main_ ({}),
+            additional_ (std::move (additional)),
+            sparseMain_ (std::move (main)),
+            isSparse_ (true),
+            factorization_ (Factorization::NONE),
+            sparseLU_ (),
+            qr_ (),
+            ansFundamental_ ({}),
+            ansParticular_ ({})
+            {
+                sparseMain_.Compress ();
+            }
+
+        //  RANK OF MAIN, from the factorization
+        int Rank ();
 
         //  CHECK RANK EQUALITY
-        int CheckRank ();
+        //  reduced is Q^T * additional: a right-hand side outside the column space of main
+        //  leaves something past the rank, which would raise the rank of main with it appended
+        int CheckRank (const Linear::Matrix <double>& additional, const Linear::Matrix <double>& reduced,
+                       const Linear::Matrix <double>& particular);
 
         //  SOLVE
-        void CreateFundamental (int generalRank);
-        void CreateParticular ();
+        void CreateFundamental ();
+        void CreateParticular (const Linear::Matrix <double>& additional);
+        PairMatrix Solve (const Linear::Matrix <double>& additional);
 
-        //  EXECUTE
+        //  EXECUTE, for additional given to the ctor
         PairMatrix Execute ();
-};
\ No newline at end of file
+        //  Square regular systems only: GMRES with ILU(0), or with Jacobi if the diagonal
+        //  has zeros. Throws if the tolerance is not reached.
+        PairMatrix ExecuteIterative (const Iterative::Options& options = {});
+};
@@ -1,32 +1,52 @@
 #include <fstream>
 #include <algorithm>
+#include <cstring>
 
-//#include "Reader/Language/driver.hpp"
 #include "Matrix/Matrix.hpp"
-//#include "Solver/Solver.hpp"
-//#include "Circuit/Circuit.hpp"
+#ifndef MATRIX_NO_READER
+#include "Reader/Language/driver.hpp"
+#endif
 
 #include "Generator/Generator.hpp"
 
 int main (int argc, char** argv) {
-	/*
-	std::ifstream infile { argv[1] };
-	if (!infile) {
-		ERRSTREAM << "Error opening file!" << std::endl;
+#ifndef MATRIX_NO_READER
+	//	main <circuit> [--loop | --mna | --mna-iterative]: currents of every given edge
+	if (argc > 1) {
+		Circuit::Mode mode = Circuit::Mode::LOOP;
+		for (int i = 2; i < argc; ++i) {
+			if (!std::strcmp (argv[i], "--loop")) {
+				mode = Circuit::Mode::LOOP;
+			}
+			else if (!std::strcmp (argv[i], "--mna")) {
+				mode = Circuit::Mode::NODAL;
+			}
+			else if (!std::strcmp (argv[i], "--mna-iterative")) {
+				mode = Circuit::Mode::NODAL_ITERATIVE;
+			}
+			else {
+				ERRSTREAM << "Unknown option " << argv[i] << ", expected --loop, --mna or --mna-iterative" << std::endl;
+				return ErrorCodes::ERROR_INV_ARG;
+			}
+		}
+		std::ifstream infile { argv[1] };
+		if (!infile) {
+			ERRSTREAM << "Error opening file!" << std::endl;
+			return 0;
+		}
+		yy::LangDriver driver { infile };
+		if (driver.parse ()) {
+			driver.execute (mode);
+		}
 		return 0;
 	}
-	*/
+#endif
 	Generator test {};
 	test.Execute ();
 	/*
-	yy::LangDriver driver { infile };
-	if (driver.parse ()) {
-		driver.execute ();
-	}
-	
 	Linear::Matrix <double> m1 {};
 	infile >> m1;
 	std::cout << m1 << std::endl << "Determinant = " << m1.Determinant (Linear::Determinant::Type::GAUSS) << std::endl;
 	*/
 	return 0;
-}
\ No newline at end of file
+}